@@ -34,6 +34,7 @@ Software Foundation, 59 Temple Place - Suite 330, Boston, MA
 #include "cpplib.h"
 #include "target.h"
 #include "langhooks.h"
+#include "hashtab.h"
 
 static void init_attributes (void);
 
@@ -43,12 +44,77 @@ static const struct attribute_spec *attribute_tables[4];
 
 static bool attributes_initialized = false;
 
+/* Hash table mapping attribute names, without any surrounding
+   underscores, to their attribute_spec.  */
+static htab_t attribute_hash;
+
+/* A name that is not NUL-terminated at its end, such as the `text'
+   part of `__text__'.  */
+struct substring
+{
+  const char *str;
+  int length;
+};
+
 /* Default empty table of attributes.  */
 static const struct attribute_spec empty_attribute_table[] =
 {
   { NULL, 0, 0, false, false, false, NULL }
 };
 
+/* Return the hash of the LEN characters at STR.  */
+
+static hashval_t
+substring_hash (const char *str, int len)
+{
+  return str[0] + str[len - 1] * 256 + len * 65536;
+}
+
+/* Hash and comparison callbacks for attribute_hash.  Entries are
+   attribute_specs; lookups are made with struct substring.  */
+
+static hashval_t
+hash_attr (const void *p)
+{
+  const struct attribute_spec *spec = p;
+  return substring_hash (spec->name, strlen (spec->name));
+}
+
+static int
+eq_attr (const void *p, const void *q)
+{
+  const struct attribute_spec *spec = p;
+  const struct substring *str = q;
+
+  return (!strncmp (spec->name, str->str, str->length)
+	  && !spec->name[str->length]);
+}
+
+/* Return the attribute_spec for the attribute named by identifier NAME,
+   which may be spelled either `text' or `__text__', or NULL if there
+   is no such attribute.  */
+
+static const struct attribute_spec *
+lookup_attribute_spec (tree name)
+{
+  struct substring attr;
+
+  if (TREE_CODE (name) != IDENTIFIER_NODE)
+    return NULL;
+
+  attr.str = IDENTIFIER_POINTER (name);
+  attr.length = IDENTIFIER_LENGTH (name);
+  if (attr.length > 4 && attr.str[0] == '_' && attr.str[1] == '_'
+      && attr.str[attr.length - 1] == '_' && attr.str[attr.length - 2] == '_')
+    {
+      attr.str += 2;
+      attr.length -= 4;
+    }
+
+  return htab_find_with_hash (attribute_hash, &attr,
+			      substring_hash (attr.str, attr.length));
+}
+
 /* Initialize attribute tables, and make some sanity checks
    if --enable-checking.  */
 
@@ -124,6 +190,29 @@ init_attributes (void)
     }
 #endif
 
+  attribute_hash = htab_create (200, hash_attr, eq_attr, NULL);
+  for (i = 0; i < ARRAY_SIZE (attribute_tables); i++)
+    {
+      int j;
+
+      for (j = 0; attribute_tables[i][j].name != NULL; j++)
+	{
+	  struct substring str;
+	  void **slot;
+
+	  str.str = attribute_tables[i][j].name;
+	  str.length = strlen (str.str);
+	  slot = htab_find_slot_with_hash (attribute_hash, &str,
+					   substring_hash (str.str,
+							   str.length),
+					   INSERT);
+	  /* An earlier table takes precedence, as when the tables
+	     were searched in order.  */
+	  if (*slot == NULL)
+	    *slot = (void *) &attribute_tables[i][j];
+	}
+    }
+
   attributes_initialized = true;
 }
 
@@ -152,26 +241,9 @@ decl_attributes (tree *node, tree attributes, int flags)
       tree name = TREE_PURPOSE (a);
       tree args = TREE_VALUE (a);
       tree *anode = node;
-      const struct attribute_spec *spec = NULL;
+      const struct attribute_spec *spec = lookup_attribute_spec (name);
       bool no_add_attrs = 0;
       tree fn_ptr_tmp = NULL_TREE;
-      size_t i;
-
-      for (i = 0; i < ARRAY_SIZE (attribute_tables); i++)
-	{
-	  int j;
-
-	  for (j = 0; attribute_tables[i][j].name != NULL; j++)
-	    {
-	      if (is_attribute_p (attribute_tables[i][j].name, name))
-		{
-		  spec = &attribute_tables[i][j];
-		  break;
-		}
-	    }
-	  if (spec != NULL)
-	    break;
-	}
 
       if (spec == NULL)
 	{
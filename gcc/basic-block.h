@@ -475,6 +475,9 @@ enum update_life_extent
 #define PROP_SCAN_DEAD_STORES	256	/* Scan for dead code.  */
 #define PROP_ASM_SCAN		512	/* Internal flag used within flow.c
 					   to flag analysis of asms.  */
+#define PROP_SKIP_CLEAN_BLOCKS	1024	/* Internal flag used within flow.c
+					   to rescan only dirty blocks and
+					   blocks whose live_at_end changes.  */
 #define PROP_FINAL		(PROP_DEATH_NOTES | PROP_LOG_LINKS  \
 				 | PROP_REG_INFO | PROP_KILL_DEAD_CODE  \
 				 | PROP_SCAN_DEAD_CODE | PROP_AUTOINC \
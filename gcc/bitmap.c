@@ -499,7 +499,12 @@ bitmap_last_set_bit (bitmap a)
 }
 
 /* Store in bitmap TO the result of combining bitmap FROM1 and FROM2 using
-   a specific bit manipulation.  Return true if TO changes.  */
+   a specific bit manipulation.  Return true if TO changes.
+
+   TO may be the same bitmap as FROM1 or FROM2.  The elements of the
+   result are produced in order, so they are simply appended to TO.
+   No element is allocated for an index where the result is known to
+   be empty, and the walk stops as soon as no more bits can be set.  */
 
 int
 bitmap_operation (bitmap to, bitmap from1, bitmap from2,
@@ -512,6 +517,7 @@ bitmap_operation (bitmap to, bitmap from1, bitmap from2,
   unsigned int indx1 = (from1_ptr) ? from1_ptr->indx : HIGHEST_INDEX;
   unsigned int indx2 = (from2_ptr) ? from2_ptr->indx : HIGHEST_INDEX;
   bitmap_element *to_ptr = to->first;
+  bitmap_element *to_last = 0;
   bitmap_element *from1_tmp;
   bitmap_element *from2_tmp;
   bitmap_element *to_tmp;
@@ -553,6 +559,14 @@ bitmap_operation (bitmap to, bitmap from1, bitmap from2,
 
   while (from1_ptr != 0 || from2_ptr != 0)
     {
+      /* Nothing more can be set once FROM1 is exhausted for an `and',
+	 or FROM2 for a plain `and'.  */
+      if (from1_ptr == 0
+	  && (operation == BITMAP_AND || operation == BITMAP_AND_COMPL))
+	break;
+      if (from2_ptr == 0 && operation == BITMAP_AND)
+	break;
+
       /* Figure out whether we need to substitute zero elements for
 	 missing links.  */
       if (indx1 == indx2)
@@ -572,6 +586,9 @@ bitmap_operation (bitmap to, bitmap from1, bitmap from2,
 	  from2_tmp = &bitmap_zero_bits;
 	  from1_ptr = from1_ptr->next;
 	  indx1 = (from1_ptr) ? from1_ptr->indx : HIGHEST_INDEX;
+
+	  if (operation == BITMAP_AND)
+	    continue;
 	}
       else
 	{
@@ -580,6 +597,9 @@ bitmap_operation (bitmap to, bitmap from1, bitmap from2,
 	  from2_tmp = from2_ptr;
 	  from2_ptr = from2_ptr->next;
 	  indx2 = (from2_ptr) ? from2_ptr->indx : HIGHEST_INDEX;
+
+	  if (operation == BITMAP_AND || operation == BITMAP_AND_COMPL)
+	    continue;
 	}
 
       /* Find the appropriate element from TO.  Begin by discarding
@@ -628,7 +648,13 @@ bitmap_operation (bitmap to, bitmap from1, bitmap from2,
       if (! bitmap_element_zerop (to_tmp))
 	{
 	  to_tmp->indx = indx;
-	  bitmap_element_link (to, to_tmp);
+	  to_tmp->next = 0;
+	  to_tmp->prev = to_last;
+	  if (to_last)
+	    to_last->next = to_tmp;
+	  else
+	    to->first = to_tmp;
+	  to_last = to_tmp;
 	}
       else
 	{
@@ -636,6 +662,14 @@ bitmap_operation (bitmap to, bitmap from1, bitmap from2,
 	}
     }
 
+  /* Leave the last element as the current one, as linking them one
+     at a time would have.  */
+  if (to_last)
+    {
+      to->current = to_last;
+      to->indx = to_last->indx;
+    }
+
   /* If we have elements of TO left over, free the lot.  */
   if (to_ptr)
     {
@@ -659,19 +693,35 @@ bitmap_operation (bitmap to, bitmap from1, bitmap from2,
   return changed;
 }
 
-/* Return true if two bitmaps are identical.  */
+/* Return true if two bitmaps are identical.  No element of a bitmap is
+   ever all zero, so this is a matter of comparing the two lists.  */
 
 int
 bitmap_equal_p (bitmap a, bitmap b)
 {
-  bitmap_head c;
-  int ret;
+  bitmap_element *a_elt, *b_elt;
+#if BITMAP_ELEMENT_WORDS != 2
+  int i;
+#endif
 
-  memset (&c, 0, sizeof (c));
-  ret = ! bitmap_operation (&c, a, b, BITMAP_XOR);
-  bitmap_clear (&c);
+  for (a_elt = a->first, b_elt = b->first;
+       a_elt != 0 && b_elt != 0;
+       a_elt = a_elt->next, b_elt = b_elt->next)
+    {
+      if (a_elt->indx != b_elt->indx)
+	return 0;
+#if BITMAP_ELEMENT_WORDS == 2
+      if (a_elt->bits[0] != b_elt->bits[0]
+	  || a_elt->bits[1] != b_elt->bits[1])
+	return 0;
+#else
+      for (i = 0; i < BITMAP_ELEMENT_WORDS; i++)
+	if (a_elt->bits[i] != b_elt->bits[i])
+	  return 0;
+#endif
+    }
 
-  return ret;
+  return a_elt == b_elt;
 }
 
 /* Or into bitmap TO bitmap FROM1 and'ed with the complement of
@@ -181,6 +181,9 @@ create_edge (struct cgraph_node *caller, struct cgraph_node *callee)
   edge->caller = caller;
   edge->callee = callee;
   edge->next_caller = callee->callers;
+  edge->prev_caller = NULL;
+  if (callee->callers)
+    callee->callers->prev_caller = edge;
   edge->next_callee = caller->callees;
   caller->callees = edge;
   callee->callers = edge;
@@ -192,20 +195,29 @@ create_edge (struct cgraph_node *caller, struct cgraph_node *callee)
 void
 cgraph_remove_edge (struct cgraph_node *caller, struct cgraph_node *callee)
 {
-  struct cgraph_edge **edge, **edge2;
+  struct cgraph_edge **edge2, *edge;
 
-  for (edge = &callee->callers; *edge && (*edge)->caller != caller;
-       edge = &((*edge)->next_caller))
-    continue;
-  if (!*edge)
-    abort ();
-  *edge = (*edge)->next_caller;
+  /* The list of callees of CALLER is usually short, while CALLEE may be
+     called from thousands of functions in a large unit.  Find the edge
+     via the former and unlink it from the latter using PREV_CALLER.  */
   for (edge2 = &caller->callees; *edge2 && (*edge2)->callee != callee;
        edge2 = &(*edge2)->next_callee)
     continue;
   if (!*edge2)
     abort ();
-  *edge2 = (*edge2)->next_callee;
+  edge = *edge2;
+  *edge2 = edge->next_callee;
+
+  if (edge->prev_caller)
+    edge->prev_caller->next_caller = edge->next_caller;
+  else
+    {
+      if (callee->callers != edge)
+	abort ();
+      callee->callers = edge->next_caller;
+    }
+  if (edge->next_caller)
+    edge->next_caller->prev_caller = edge->prev_caller;
 }
 
 /* Remove the node from cgraph.  */
@@ -132,6 +132,9 @@ struct cgraph_edge GTY(())
   struct cgraph_node *callee;
   struct cgraph_edge *next_caller;
   struct cgraph_edge *next_callee;
+  /* The previous edge in CALLEE's list of callers, so that an edge can
+     be unlinked without walking all callers of a popular function.  */
+  struct cgraph_edge *prev_caller;
   /* When NULL, inline this call.  When non-NULL, points to the explanation
      why function was not inlined.  */
   const char *inline_failed;
@@ -160,12 +160,15 @@ linux_gt_pch_get_address (size_t size, int fd)
    if mmap with MAP_PRIVATE works.  If it does, we are off to the
    races.  If it doesn't, we try an anonymous private mmap since the
    kernel is more likely to honor the BASE address in anonymous maps.
-   We then copy the data to the anonymous private map.  This assumes
-   of course that we don't need to change the data in the PCH file
-   after it is created.
+   Once that succeeds the address range is known to be ours, so we can
+   safely map the file over it with MAP_FIXED; the kernel then pages the
+   data in lazily as it is touched, just as in the first case.  Only if
+   even that fails do we copy the data to the anonymous private map.
+   This assumes of course that we don't need to change the data in the
+   PCH file after it is created.
 
-   This approach obviously causes a performance penalty but there is
-   little else we can do given the current PCH implementation.  */
+   Reading the whole file obviously causes a performance penalty, but
+   there is little else we can do given the current PCH implementation.  */
 
 static int
 linux_gt_pch_use_address (void *base, size_t size, int fd, size_t offset)
@@ -198,6 +201,21 @@ linux_gt_pch_use_address (void *base, size_t size, int fd, size_t offset)
       return -1;
     }
 
+  /* Replace the anonymous map with one of the file.  */
+  addr = mmap (base, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED,
+	       fd, offset);
+
+  if (addr == base)
+    return 1;
+
+  /* A failed MAP_FIXED request may have unmapped part of the range;
+     restore the anonymous map before reading into it.  */
+  addr = mmap (base, size, PROT_READ | PROT_WRITE,
+	       MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+
+  if (addr != base)
+    return -1;
+
   if (lseek (fd, offset, SEEK_SET) == (off_t)-1)
     return -1;
 
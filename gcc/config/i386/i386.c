@@ -7127,7 +7127,7 @@ output_pic_addr_const (FILE *file, rtx x, int code)
       break;
 
     case CONST_INT:
-      fprintf (file, HOST_WIDE_INT_PRINT_DEC, INTVAL (x));
+      fprint_w (file, INTVAL (x));
       break;
 
     case CONST:
@@ -7954,7 +7954,7 @@ print_operand (FILE *file, rtx x, int code)
 	    }
 	}
       if (GET_CODE (x) == CONST_INT)
-	fprintf (file, HOST_WIDE_INT_PRINT_DEC, INTVAL (x));
+	fprint_w (file, INTVAL (x));
       else if (flag_pic)
 	output_pic_addr_const (file, x, code);
       else
@@ -8005,7 +8005,7 @@ print_operand_address (FILE *file, rtx addr)
 		putc ('%', file);
 	      fputs ("ds:", file);
 	    }
-	  fprintf (file, HOST_WIDE_INT_PRINT_DEC, INTVAL (disp));
+	  fprint_w (file, INTVAL (disp));
 	}
       else if (flag_pic)
 	output_pic_addr_const (file, disp, 0);
@@ -8084,11 +8084,11 @@ print_operand_address (FILE *file, rtx addr)
 		{
 		  if (INTVAL (offset) >= 0)
 		    putc ('+', file);
-		  fprintf (file, HOST_WIDE_INT_PRINT_DEC, INTVAL (offset));
+		  fprint_w (file, INTVAL (offset));
 		}
 	    }
 	  else if (offset)
-	    fprintf (file, HOST_WIDE_INT_PRINT_DEC, INTVAL (offset));
+	    fprint_w (file, INTVAL (offset));
 	  else
 	    putc ('0', file);
 
@@ -730,6 +730,10 @@ add_method (tree type, tree method, int error_p)
   if (method == error_mark_node)
     return;
   
+  /* Earlier lookups in TYPE will not have seen METHOD.  */
+  if (error_p)
+    clear_member_lookups ();
+
   using = (DECL_CONTEXT (method) != type);
   template_conv_p = (TREE_CODE (method) == TEMPLATE_DECL
                      && DECL_TEMPLATE_CONV_FN_P (method));
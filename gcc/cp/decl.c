@@ -1596,9 +1596,7 @@ duplicate_decls (tree newdecl, tree olddecl)
   if (TREE_CODE (newdecl) == TEMPLATE_DECL)
     {
       TREE_TYPE (olddecl) = TREE_TYPE (DECL_TEMPLATE_RESULT (olddecl));
-      DECL_TEMPLATE_SPECIALIZATIONS (olddecl)
-	= chainon (DECL_TEMPLATE_SPECIALIZATIONS (olddecl),
-		   DECL_TEMPLATE_SPECIALIZATIONS (newdecl));
+      merge_specializations (olddecl, newdecl);
 
       /* If the new declaration is a definition, update the file and
 	 line information on the declaration.  */
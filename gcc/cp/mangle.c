@@ -101,6 +101,10 @@ static struct globals
      we've seen them.  */
   varray_type substitutions;
 
+  /* A table of struct substitution_entry, mapping the type candidates
+     in SUBSTITUTIONS to their positions.  */
+  htab_t type_substitutions;
+
   /* The entity that is being mangled.  */
   tree entity;
 
@@ -109,6 +113,15 @@ static struct globals
   bool need_abi_warning;
 } G;
 
+/* An entry in G.TYPE_SUBSTITUTIONS.  */
+struct substitution_entry
+{
+  /* The canonicalized type.  */
+  tree node;
+  /* Its index in G.SUBSTITUTIONS.  */
+  int index;
+};
+
 /* Indices into subst_identifiers.  These are identifiers used in
    special substitution rules.  */
 typedef enum
@@ -156,6 +169,8 @@ static inline int is_std_substitution (const tree,
 static inline int is_std_substitution_char (const tree,
 					    const substitution_identifier_index_t);
 static int find_substitution (tree);
+static hashval_t hash_substitution_entry (const void *);
+static int eq_substitution_entry (const void *, const void *);
 static void mangle_call_offset (const tree, const tree);
 
 /* Functions for emitting mangled representations of things.  */
@@ -337,6 +352,22 @@ canonicalize_for_substitution (tree node)
   return node;
 }
 
+/* Hash P, a struct substitution_entry.  */
+
+static hashval_t
+hash_substitution_entry (const void *p)
+{
+  return htab_hash_pointer (((const struct substitution_entry *) p)->node);
+}
+
+/* Compare P1, a struct substitution_entry, with P2, a type.  */
+
+static int
+eq_substitution_entry (const void *p1, const void *p2)
+{
+  return ((const struct substitution_entry *) p1)->node == (tree) p2;
+}
+
 /* Add NODE as a substitution candidate.  NODE must not already be on
    the list of candidates.  */
 
@@ -376,6 +407,21 @@ add_substitution (tree node)
   /* Put the decl onto the varray of substitution candidates.  */
   VARRAY_PUSH_TREE (G.substitutions, node);
 
+  /* And remember where a type went, so that find_substitution can
+     find it again quickly.  */
+  if (TYPE_P (node))
+    {
+      struct substitution_entry *entry;
+      void **slot;
+
+      slot = htab_find_slot_with_hash (G.type_substitutions, node,
+				       htab_hash_pointer (node), INSERT);
+      entry = xmalloc (sizeof (struct substitution_entry));
+      entry->node = node;
+      entry->index = VARRAY_ACTIVE_SIZE (G.substitutions) - 1;
+      *slot = entry;
+    }
+
   if (DEBUG_MANGLE)
     dump_substitution_candidates ();
 }
@@ -583,7 +629,21 @@ find_substitution (tree node)
     }
 
   /* Now check the list of available substitutions for this mangling
-     operation.  */
+     operation.  A type can match only one candidate, so if the very
+     same type is there we need look no further.  */
+  if (TYPE_P (node))
+    {
+      struct substitution_entry *entry;
+
+      entry = htab_find_with_hash (G.type_substitutions, node,
+				   htab_hash_pointer (node));
+      if (entry)
+	{
+	  write_substitution (entry->index);
+	  return 1;
+	}
+    }
+
   for (i = 0; i < size; ++i)
     {
       tree candidate = VARRAY_TREE (G.substitutions, i);
@@ -2388,6 +2448,7 @@ start_mangling (const tree entity)
   G.entity = entity;
   G.need_abi_warning = false;
   VARRAY_TREE_INIT (G.substitutions, 1, "mangling substitutions");
+  htab_empty (G.type_substitutions);
   obstack_free (&G.name_obstack, obstack_base (&G.name_obstack));
 }
 
@@ -2418,6 +2479,8 @@ void
 init_mangle (void)
 {
   gcc_obstack_init (&G.name_obstack);
+  G.type_substitutions = htab_create (37, hash_substitution_entry,
+				      eq_substitution_entry, free);
 
   /* Cache these identifiers for quick comparison when checking for
      standard substitutions.  */
@@ -1686,6 +1686,10 @@ static bool cp_parser_next_token_ends_template_argument_p
   (cp_parser *);
 static bool cp_parser_nth_token_starts_template_argument_list_p
   (cp_parser *, size_t);
+static bool cp_parser_token_starts_name_p
+  (cp_token *);
+static bool cp_parser_token_starts_simple_type_specifier_p
+  (cp_token *);
 static enum tag_types cp_parser_token_is_class_key
   (cp_token *);
 static void cp_parser_check_class_key
@@ -2830,6 +2834,10 @@ cp_parser_unqualified_id (cp_parser* parser,
       {
 	tree id;
 
+	/* A template-id must have a `<' after the name; without one
+	   there is no need to set up a tentative parse.  */
+	if (!cp_parser_nth_token_starts_template_argument_list_p (parser, 2))
+	  return cp_parser_identifier (parser);
 	/* We don't know yet whether or not this will be a
 	   template-id.  */
 	cp_parser_parse_tentatively (parser);
@@ -3571,18 +3579,26 @@ cp_parser_postfix_expression (cp_parser *parser, bool address_p)
 	   looking at a functional cast.  We could also be looking at
 	   an id-expression.  So, we try the functional cast, and if
 	   that doesn't work we fall back to the primary-expression.  */
-	cp_parser_parse_tentatively (parser);
-	/* Look for the simple-type-specifier.  */
-	type = cp_parser_simple_type_specifier (parser, 
-						CP_PARSER_FLAGS_NONE,
-						/*identifier_p=*/false);
-	/* Parse the cast itself.  */
-	if (!cp_parser_error_occurred (parser))
-	  postfix_expression 
-	    = cp_parser_functional_cast (parser, type);
-	/* If that worked, we're done.  */
-	if (cp_parser_parse_definitely (parser))
-	  break;
+	if (cp_parser_token_starts_simple_type_specifier_p (token))
+	  {
+	    cp_parser_parse_tentatively (parser);
+	    /* Look for the simple-type-specifier.  */
+	    type = cp_parser_simple_type_specifier (parser, 
+						    CP_PARSER_FLAGS_NONE,
+						    /*identifier_p=*/false);
+	    /* Parse the cast itself.  */
+	    if (!cp_parser_error_occurred (parser))
+	      postfix_expression 
+		= cp_parser_functional_cast (parser, type);
+	    /* If that worked, we're done.  */
+	    if (cp_parser_parse_definitely (parser))
+	      break;
+	  }
+	else
+	  /* The failed attempt would have cleared the scope while
+	     looking for a `::'; do the same here.  */
+	  cp_parser_global_scope_opt (parser,
+				      /*current_scope_valid_p=*/false);
 
 	/* If the functional-cast didn't work out, try a
 	   compound-literal.  */
@@ -9033,19 +9049,28 @@ cp_parser_type_name (cp_parser* parser)
 {
   tree type_decl;
   tree identifier;
+  cp_token *token;
+  bool class_name_p = false;
 
-  /* We can't know yet whether it is a class-name or not.  */
-  cp_parser_parse_tentatively (parser);
-  /* Try a class-name.  */
-  type_decl = cp_parser_class_name (parser, 
-				    /*typename_keyword_p=*/false,
-				    /*template_keyword_p=*/false,
-				    /*type_p=*/false,
-				    /*check_dependency_p=*/true,
-				    /*class_head_p=*/false,
-				    /*is_declaration=*/false);
+  /* Every class-name starts with an identifier or a template-id, so
+     there is no point trying one anywhere else.  */
+  token = cp_lexer_peek_token (parser->lexer);
+  if (token->type == CPP_NAME || token->type == CPP_TEMPLATE_ID)
+    {
+      /* We can't know yet whether it is a class-name or not.  */
+      cp_parser_parse_tentatively (parser);
+      /* Try a class-name.  */
+      type_decl = cp_parser_class_name (parser, 
+					/*typename_keyword_p=*/false,
+					/*template_keyword_p=*/false,
+					/*type_p=*/false,
+					/*check_dependency_p=*/true,
+					/*class_head_p=*/false,
+					/*is_declaration=*/false);
+      class_name_p = cp_parser_parse_definitely (parser);
+    }
   /* If it's not a class-name, keep looking.  */
-  if (!cp_parser_parse_definitely (parser))
+  if (!class_name_p)
     {
       /* It must be a typedef-name or an enum-name.  */
       identifier = cp_parser_identifier (parser);
@@ -10760,6 +10785,16 @@ cp_parser_ptr_operator (cp_parser* parser,
     }
   else
     {
+      /* A pointer-to-member must start with a name; anything else is
+	 not a ptr-operator at all.  */
+      if (!cp_parser_token_starts_name_p (token))
+	{
+	  /* Clear the scope, as looking for the `::' would have.  */
+	  cp_parser_global_scope_opt (parser,
+				      /*current_scope_valid_p=*/false);
+	  cp_parser_error (parser, "expected ptr-operator");
+	  return code;
+	}
       /* Try the pointer-to-member case.  */
       cp_parser_parse_tentatively (parser);
       /* Look for the optional `::' operator.  */
@@ -15241,6 +15276,44 @@ cp_parser_nth_token_starts_template_argument_list_p (cp_parser * parser,
     }
   return false;
 }
+
+/* Returns TRUE iff TOKEN can begin a possibly qualified name: an
+   identifier, a template-id, a nested-name-specifier, or a `::'.  */
+
+static bool
+cp_parser_token_starts_name_p (cp_token* token)
+{
+  return (token->type == CPP_NAME
+	  || token->type == CPP_TEMPLATE_ID
+	  || token->type == CPP_NESTED_NAME_SPECIFIER
+	  || token->type == CPP_SCOPE);
+}
+
+/* Returns TRUE iff TOKEN can begin a simple-type-specifier.  */
+
+static bool
+cp_parser_token_starts_simple_type_specifier_p (cp_token* token)
+{
+  switch (token->keyword)
+    {
+    case RID_CHAR:
+    case RID_WCHAR:
+    case RID_BOOL:
+    case RID_SHORT:
+    case RID_INT:
+    case RID_LONG:
+    case RID_SIGNED:
+    case RID_UNSIGNED:
+    case RID_FLOAT:
+    case RID_DOUBLE:
+    case RID_VOID:
+    case RID_TYPEOF:
+      return true;
+
+    default:
+      return cp_parser_token_starts_name_p (token);
+    }
+}
  
 /* Returns the kind of tag indicated by TOKEN, if it is a class-key,
    or none_type otherwise.  */
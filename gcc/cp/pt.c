@@ -72,6 +72,51 @@ static GTY(()) tree saved_access_scope;
    local variables.  */
 static htab_t local_specializations;
 
+/* A map from (type, arguments) pairs to the result of substituting
+   the arguments into a class template specialization, in the
+   instantiation presently being performed.  Within one instantiation
+   the same argument vector is used over and over again, and looking
+   up the result here saves building a new argument vector for each
+   use of a type like `S<T>'.  */
+static htab_t tsubst_aggr_memo;
+
+/* An entry in the TSUBST_AGGR_MEMO hash table.  */
+struct tsubst_aggr_entry
+{
+  tree t;
+  tree args;
+  tsubst_flags_t complain;
+  int entering_scope;
+  /* The value of PROCESSING_TEMPLATE_DECL.  */
+  int template_depth;
+  /* The result of the substitution.  */
+  tree r;
+};
+
+/* An entry in the DECL_SPECIALIZATIONS or CLASS_INSTANTIATIONS hash
+   tables.  NODE is the TREE_LIST node on the corresponding list of
+   TMPL whose TREE_PURPOSE is ARGS.  When several nodes on the list
+   have equivalent arguments, NODE is the first of them, which is the
+   one a linear search of the list would find.  */
+
+struct spec_entry GTY(())
+{
+  tree tmpl;
+  tree args;
+  tree node;
+  hashval_t hash;
+  /* Nonzero if some node after NODE on the list may have arguments
+     equivalent to ARGS.  */
+  unsigned char shadowed;
+};
+
+/* Indexes DECL_TEMPLATE_SPECIALIZATIONS, so that retrieving a
+   specialization does not require a walk of the whole list.  */
+static GTY ((param_is (struct spec_entry))) htab_t decl_specializations;
+
+/* Likewise for the DECL_TEMPLATE_INSTANTIATIONS of class templates.  */
+static GTY ((param_is (struct spec_entry))) htab_t class_instantiations;
+
 #define UNIFY_ALLOW_NONE 0
 #define UNIFY_ALLOW_MORE_CV_QUAL 1
 #define UNIFY_ALLOW_LESS_CV_QUAL 2
@@ -118,6 +163,19 @@ static int for_each_template_parm (tree, tree_fn_t, void*, htab_t);
 static tree build_template_parm_index (int, int, int, tree, tree);
 static int inline_needs_template_parms (tree);
 static void push_inline_template_parms_recursive (tree, int);
+static hashval_t hash_template_arg (tree, bool *);
+static hashval_t hash_template_args (tree, bool *);
+static hashval_t hash_template_type_arg (tree, bool *);
+static hashval_t hash_spec_entry (const void *);
+static int eq_spec_entry (const void *, const void *);
+static hashval_t hash_tmpl_and_args (tree, tree, bool *);
+static void **find_spec_slot (htab_t, tree, tree, hashval_t);
+static tree lookup_template_list_node (htab_t, tree, tree, tree, hashval_t,
+				       bool);
+static bool template_list_args_repeated_p (htab_t, tree, tree, hashval_t,
+					   bool);
+static void add_template_list_node (htab_t *, tree, tree, bool, hashval_t);
+static void remove_template_list_node (htab_t, tree, tree, tree);
 static tree retrieve_specialization (tree, tree);
 static tree retrieve_local_specialization (tree);
 static tree register_specialization (tree, tree, tree);
@@ -163,6 +221,10 @@ static tree copy_default_args_to_explicit_spec_1 (tree, tree);
 static void copy_default_args_to_explicit_spec (tree);
 static int invalid_nontype_parm_type_p (tree, tsubst_flags_t);
 static int eq_local_specializations (const void *, const void *);
+static hashval_t hash_tsubst_aggr_entry (const void *);
+static int eq_tsubst_aggr_entry (const void *, const void *);
+static htab_t push_tsubst_aggr_memo (void);
+static void pop_tsubst_aggr_memo (htab_t);
 static bool dependent_type_p_r (tree);
 static tree tsubst (tree, tree, tsubst_flags_t, tree);
 static tree tsubst_expr	(tree, tree, tsubst_flags_t, tree);
@@ -835,6 +897,349 @@ maybe_process_partial_specialization (tree type)
     error ("explicit specialization of non-template `%T'", type);
 }
 
+/* Return a hash value for the type template argument T which is
+   consistent with same_type_p: types that same_type_p considers the
+   same hash to the same value.  Set *UNHASHABLE if T involves a
+   TYPENAME_TYPE, which comptypes may resolve to some other type.
+
+   The tables are saved in PCH files, where nodes get new addresses,
+   so hash values are built from UIDs rather than from pointers.  */
+
+static hashval_t
+hash_template_type_arg (tree t, bool *unhashable)
+{
+  hashval_t val;
+  tree arg;
+
+  if (TREE_CODE (t) == INTEGER_TYPE && TYPE_IS_SIZETYPE (t)
+      && TYPE_DOMAIN (t))
+    t = TYPE_DOMAIN (t);
+  if (TYPE_PTRMEMFUNC_P (t))
+    t = TYPE_PTRMEMFUNC_FN_TYPE (t);
+
+  val = TREE_CODE (t);
+  /* The qualifiers of an array type are checked on its elements.  */
+  if (TREE_CODE (t) != ARRAY_TYPE)
+    val = val * 8 + TYPE_QUALS (t);
+
+  switch (TREE_CODE (t))
+    {
+    case TEMPLATE_TYPE_PARM:
+    case TEMPLATE_TEMPLATE_PARM:
+    case BOUND_TEMPLATE_TEMPLATE_PARM:
+      val = iterative_hash_object (TEMPLATE_TYPE_IDX (t), val);
+      return iterative_hash_object (TEMPLATE_TYPE_LEVEL (t), val);
+
+    case RECORD_TYPE:
+    case UNION_TYPE:
+      /* Instantiations of the same template with the same arguments
+	 are the same type, even if they are distinct nodes.  The
+	 template is hashed by name, since tsubst_template_decl may
+	 replace the TYPE_TI_TEMPLATE of a type that is already in a
+	 table.  */
+      if (TYPE_TEMPLATE_INFO (t))
+	{
+	  tree tmpl = TYPE_TI_TEMPLATE (t);
+
+	  if (DECL_P (tmpl) && DECL_NAME (tmpl))
+	    val = val * 31 + IDENTIFIER_HASH_VALUE (DECL_NAME (tmpl));
+	  return val * 31 + hash_template_args (TYPE_TI_ARGS (t), unhashable);
+	}
+      break;
+
+    case OFFSET_TYPE:
+    case POINTER_TYPE:
+    case REFERENCE_TYPE:
+    case COMPLEX_TYPE:
+    case ARRAY_TYPE:
+      return val + 31 * hash_template_type_arg (TREE_TYPE (t), unhashable);
+
+    case METHOD_TYPE:
+    case FUNCTION_TYPE:
+      val += 31 * hash_template_type_arg (TREE_TYPE (t), unhashable);
+      for (arg = TYPE_ARG_TYPES (t); arg; arg = TREE_CHAIN (arg))
+	val = val * 31 + hash_template_type_arg (TREE_VALUE (arg),
+						  unhashable);
+      return val;
+
+    case TYPENAME_TYPE:
+      *unhashable = true;
+      return 0;
+
+    case UNBOUND_CLASS_TEMPLATE:
+      return val;
+
+    default:
+      break;
+    }
+
+  return iterative_hash_object (TYPE_UID (TYPE_MAIN_VARIANT (t)), val);
+}
+
+/* Return a hash value for the template argument ARG which is
+   consistent with template_args_equal.  */
+
+static hashval_t
+hash_template_arg (tree arg, bool *unhashable)
+{
+  if (arg == NULL_TREE)
+    return 0;
+  if (TREE_CODE (arg) == TREE_VEC)
+    return hash_template_args (arg, unhashable);
+  if (TYPE_P (arg))
+    return hash_template_type_arg (arg, unhashable);
+
+  /* cp_tree_equal looks through these.  */
+  while (TREE_CODE (arg) == NOP_EXPR
+	 || TREE_CODE (arg) == CONVERT_EXPR
+	 || TREE_CODE (arg) == NON_LVALUE_EXPR)
+    arg = TREE_OPERAND (arg, 0);
+
+  if (TREE_CODE (arg) == INTEGER_CST)
+    return (hashval_t) (TREE_INT_CST_LOW (arg) ^ TREE_INT_CST_HIGH (arg));
+  return TREE_CODE (arg);
+}
+
+/* Return a hash value for the vector of template arguments ARGS.  */
+
+static hashval_t
+hash_template_args (tree args, bool *unhashable)
+{
+  hashval_t val = TREE_VEC_LENGTH (args);
+  int i;
+
+  for (i = 0; i < TREE_VEC_LENGTH (args); ++i)
+    val = val * 31 + hash_template_arg (TREE_VEC_ELT (args, i), unhashable);
+  return val;
+}
+
+/* Return the hash value under which the specialization of TMPL for
+   ARGS is entered in DECL_SPECIALIZATIONS or CLASS_INSTANTIATIONS.
+   If ARGS cannot be hashed reliably, set *UNHASHABLE and return the
+   value shared by all such specializations of TMPL.  */
+
+static hashval_t
+hash_tmpl_and_args (tree tmpl, tree args, bool *unhashable)
+{
+  hashval_t val = DECL_UID (tmpl);
+  hashval_t args_val;
+
+  *unhashable = false;
+  args_val = hash_template_args (args, unhashable);
+  if (*unhashable)
+    return val;
+  return val + 31 * args_val;
+}
+
+/* Hash P, a struct spec_entry.  */
+
+static hashval_t
+hash_spec_entry (const void *p)
+{
+  return ((const struct spec_entry *) p)->hash;
+}
+
+/* Compare the struct spec_entry P1 with the key P2.  */
+
+static int
+eq_spec_entry (const void *p1, const void *p2)
+{
+  const struct spec_entry *e1 = (const struct spec_entry *) p1;
+  const struct spec_entry *e2 = (const struct spec_entry *) p2;
+
+  return (e1->hash == e2->hash
+	  && e1->tmpl == e2->tmpl
+	  && comp_template_args (e1->args, e2->args));
+}
+
+/* Return the slot of the entry for the specialization of TMPL for
+   ARGS in TABLE, or NULL if there is none.  HASH is the value of
+   hash_tmpl_and_args for TMPL and ARGS.  */
+
+static void **
+find_spec_slot (htab_t table, tree tmpl, tree args, hashval_t hash)
+{
+  struct spec_entry key;
+
+  if (!table)
+    return NULL;
+  key.tmpl = tmpl;
+  key.args = args;
+  key.hash = hash;
+  return htab_find_slot_with_hash (table, &key, hash, NO_INSERT);
+}
+
+/* Return the first node on LIST, the list of specializations or
+   instantiations of TMPL indexed by TABLE, whose TREE_PURPOSE is
+   equivalent to ARGS.  Return NULL_TREE if there is no such node.
+   HASH and UNHASHABLE are what hash_tmpl_and_args returned for TMPL
+   and ARGS.  */
+
+static tree
+lookup_template_list_node (htab_t table, tree tmpl, tree list, tree args,
+			   hashval_t hash, bool unhashable)
+{
+  void **slot;
+
+  if (unhashable)
+    {
+      /* Any node on the list might be equivalent.  */
+      for (; list; list = TREE_CHAIN (list))
+	if (comp_template_args (TREE_PURPOSE (list), args))
+	  return list;
+      return NULL_TREE;
+    }
+
+  slot = find_spec_slot (table, tmpl, args, hash);
+  if (!slot)
+    /* The node may have been entered with arguments that could not
+       be hashed.  */
+    slot = find_spec_slot (table, tmpl, args, DECL_UID (tmpl));
+  return slot ? ((struct spec_entry *) *slot)->node : NULL_TREE;
+}
+
+/* Return true if more than one node on the list of specializations or
+   instantiations of TMPL indexed by TABLE may have a TREE_PURPOSE
+   equivalent to ARGS, so that lookup_template_list_node finds only
+   the first of them.  HASH and UNHASHABLE are as for
+   lookup_template_list_node.  */
+
+static bool
+template_list_args_repeated_p (htab_t table, tree tmpl, tree args,
+			       hashval_t hash, bool unhashable)
+{
+  void **slot;
+  int n = 0;
+
+  if (unhashable)
+    return true;
+  slot = find_spec_slot (table, tmpl, args, hash);
+  if (slot)
+    {
+      if (((struct spec_entry *) *slot)->shadowed)
+	return true;
+      n++;
+    }
+
+  /* Nodes entered with arguments that could not be hashed share one
+     hash value, and one of them may be equivalent to ARGS too.  */
+  slot = find_spec_slot (table, tmpl, args, DECL_UID (tmpl));
+  if (slot)
+    {
+      if (((struct spec_entry *) *slot)->shadowed)
+	return true;
+      n++;
+    }
+  return n > 1;
+}
+
+/* Enter NODE, which has just been put on the list of specializations
+   or instantiations of TMPL indexed by *TABLEP, into that table.
+   AT_FRONT is true if NODE was put at the front of the list, and
+   false if it was put at the end.  HASH is the value of
+   hash_tmpl_and_args for TMPL and the TREE_PURPOSE of NODE.  */
+
+static void
+add_template_list_node (htab_t *tablep, tree tmpl, tree node, bool at_front,
+			hashval_t hash)
+{
+  struct spec_entry key;
+  struct spec_entry *entry;
+  void **slot;
+
+  if (!*tablep)
+    *tablep = htab_create_ggc (37, hash_spec_entry, eq_spec_entry, NULL);
+
+  key.tmpl = tmpl;
+  key.args = TREE_PURPOSE (node);
+  key.hash = hash;
+  slot = htab_find_slot_with_hash (*tablep, &key, key.hash, INSERT);
+  entry = *slot;
+  if (!entry)
+    {
+      entry = ggc_alloc (sizeof (struct spec_entry));
+      *entry = key;
+      entry->node = node;
+      entry->shadowed = 0;
+      *slot = entry;
+    }
+  else
+    {
+      /* Whichever node comes first on the list is the one that
+	 lookups should find.  */
+      if (at_front)
+	{
+	  entry->args = key.args;
+	  entry->node = node;
+	}
+      entry->shadowed = 1;
+    }
+}
+
+/* Remove the entry for NODE, which has just been taken off LIST, the
+   list of specializations or instantiations of TMPL indexed by TABLE,
+   from that table.  */
+
+static void
+remove_template_list_node (htab_t table, tree tmpl, tree list, tree node)
+{
+  struct spec_entry *entry;
+  void **slot;
+  bool unhashable;
+  hashval_t hash;
+
+  hash = hash_tmpl_and_args (tmpl, TREE_PURPOSE (node), &unhashable);
+  slot = find_spec_slot (table, tmpl, TREE_PURPOSE (node), hash);
+  if (!slot)
+    return;
+  entry = *slot;
+  if (entry->node != node)
+    return;
+
+  if (entry->shadowed)
+    /* Let the next node with the same arguments take its place.  */
+    for (; list; list = TREE_CHAIN (list))
+      if (comp_template_args (TREE_PURPOSE (list), entry->args))
+	{
+	  entry->args = TREE_PURPOSE (list);
+	  entry->node = list;
+	  return;
+	}
+
+  htab_clear_slot (table, slot);
+}
+
+/* Move the specializations of FROM onto the end of the list of
+   specializations of TO.  The list of FROM becomes the tail of the
+   list of TO, so the two lists share those nodes afterwards, but only
+   TO's are entered in DECL_SPECIALIZATIONS.  */
+
+void
+merge_specializations (tree to, tree from)
+{
+  tree s;
+
+  for (s = DECL_TEMPLATE_SPECIALIZATIONS (from); s; s = TREE_CHAIN (s))
+    {
+      void **slot;
+      bool unhashable;
+
+      slot = find_spec_slot (decl_specializations, from, TREE_PURPOSE (s),
+			     hash_tmpl_and_args (from, TREE_PURPOSE (s),
+						 &unhashable));
+      if (slot)
+	htab_clear_slot (decl_specializations, slot);
+      add_template_list_node (&decl_specializations, to, s,
+			      /*at_front=*/false,
+			      hash_tmpl_and_args (to, TREE_PURPOSE (s),
+						  &unhashable));
+    }
+
+  DECL_TEMPLATE_SPECIALIZATIONS (to)
+    = chainon (DECL_TEMPLATE_SPECIALIZATIONS (to),
+	       DECL_TEMPLATE_SPECIALIZATIONS (from));
+}
+
 /* Retrieve the specialization (in the sense of [temp.spec] - a
    specialization is either an instantiation or an explicit
    specialization) of TMPL for the given template ARGS.  If there is
@@ -846,6 +1251,8 @@ static tree
 retrieve_specialization (tree tmpl, tree args)
 {
   tree s;
+  hashval_t hash;
+  bool unhashable;
 
   my_friendly_assert (TREE_CODE (tmpl) == TEMPLATE_DECL, 0);
 
@@ -855,13 +1262,11 @@ retrieve_specialization (tree tmpl, tree args)
 		      == TMPL_PARMS_DEPTH (DECL_TEMPLATE_PARMS (tmpl)),
 		      0);
 		      
-  for (s = DECL_TEMPLATE_SPECIALIZATIONS (tmpl);
-       s != NULL_TREE;
-       s = TREE_CHAIN (s))
-    if (comp_template_args (TREE_PURPOSE (s), args))
-      return TREE_VALUE (s);
-
-  return NULL_TREE;
+  hash = hash_tmpl_and_args (tmpl, args, &unhashable);
+  s = lookup_template_list_node (decl_specializations, tmpl,
+				 DECL_TEMPLATE_SPECIALIZATIONS (tmpl), args,
+				 hash, unhashable);
+  return s ? TREE_VALUE (s) : NULL_TREE;
 }
 
 /* Like retrieve_specialization, but for local declarations.  */
@@ -1046,6 +1451,10 @@ static tree
 register_specialization (tree spec, tree tmpl, tree args)
 {
   tree s;
+  tree spec_args = NULL_TREE;
+  hashval_t hash, spec_hash = 0;
+  bool unhashable, spec_unhashable = false;
+  bool walk;
 
   my_friendly_assert (TREE_CODE (tmpl) == TEMPLATE_DECL, 0);
 
@@ -1070,9 +1479,42 @@ register_specialization (tree spec, tree tmpl, tree args)
 		      == TMPL_PARMS_DEPTH (DECL_TEMPLATE_PARMS (tmpl)),
 		      0);
 
-  for (s = DECL_TEMPLATE_SPECIALIZATIONS (tmpl);
-       s != NULL_TREE;
-       s = TREE_CHAIN (s))
+  hash = hash_tmpl_and_args (tmpl, args, &unhashable);
+  if (DECL_LANG_SPECIFIC (spec) && DECL_TEMPLATE_INFO (spec)
+      && DECL_TI_ARGS (spec) != args)
+    spec_args = DECL_TI_ARGS (spec);
+  if (spec_args)
+    spec_hash = hash_tmpl_and_args (tmpl, spec_args, &spec_unhashable);
+
+  /* Usually the table finds the only node whose arguments are
+     equivalent to ARGS, and SPEC, if it is on the list at all, is on
+     it under its own arguments.  When several nodes may have
+     arguments equivalent to either, walk the whole list instead, so
+     that each node is checked in order, as before the table.  */
+  walk = (template_list_args_repeated_p (decl_specializations, tmpl, args,
+					 hash, unhashable)
+	  || (spec_args
+	      && template_list_args_repeated_p (decl_specializations, tmpl,
+						spec_args, spec_hash,
+						spec_unhashable)));
+  if (walk)
+    s = DECL_TEMPLATE_SPECIALIZATIONS (tmpl);
+  else
+    {
+      if (spec_args)
+	{
+	  s = lookup_template_list_node (decl_specializations, tmpl,
+					 DECL_TEMPLATE_SPECIALIZATIONS (tmpl),
+					 spec_args, spec_hash, false);
+	  if (s && TREE_VALUE (s) == spec)
+	    return spec;
+	}
+      s = lookup_template_list_node (decl_specializations, tmpl,
+				     DECL_TEMPLATE_SPECIALIZATIONS (tmpl),
+				     args, hash, false);
+    }
+
+  for (; s != NULL_TREE; s = walk ? TREE_CHAIN (s) : NULL_TREE)
     {
       tree fn = TREE_VALUE (s);
 
@@ -1150,6 +1592,9 @@ register_specialization (tree spec, tree tmpl, tree args)
 
   DECL_TEMPLATE_SPECIALIZATIONS (tmpl)
      = tree_cons (args, spec, DECL_TEMPLATE_SPECIALIZATIONS (tmpl));
+  add_template_list_node (&decl_specializations, tmpl,
+			  DECL_TEMPLATE_SPECIALIZATIONS (tmpl),
+			  /*at_front=*/true, hash);
 
   return spec;
 }
@@ -1163,13 +1608,78 @@ reregister_specialization (tree spec, tree tmpl, tree new_spec)
 {
   tree* s;
 
+  /* SPEC is normally entered under its own template arguments, so
+     look for it there before walking the whole list.  */
+  if (DECL_LANG_SPECIFIC (spec) && DECL_TEMPLATE_INFO (spec)
+      && DECL_TI_ARGS (spec))
+    {
+      void **slot;
+      bool unhashable;
+      hashval_t hash;
+      struct spec_entry *entry;
+
+      hash = hash_tmpl_and_args (tmpl, DECL_TI_ARGS (spec), &unhashable);
+      slot = find_spec_slot (decl_specializations, tmpl,
+			     DECL_TI_ARGS (spec), hash);
+      entry = slot ? *slot : NULL;
+      if (entry && TREE_VALUE (entry->node) == spec)
+	{
+	  tree node = entry->node;
+	  tree head = DECL_TEMPLATE_SPECIALIZATIONS (tmpl);
+	  struct spec_entry *head_entry = NULL;
+
+	  if (new_spec)
+	    {
+	      TREE_VALUE (node) = new_spec;
+	      return 1;
+	    }
+
+	  /* The order of the list only matters to lookups, and only
+	     between nodes with equivalent arguments.  If there are
+	     none, take NODE off the list by moving the first node
+	     into its place.  */
+	  if (node != head)
+	    {
+	      void **head_slot;
+
+	      hash = hash_tmpl_and_args (tmpl, TREE_PURPOSE (head),
+					 &unhashable);
+	      head_slot = find_spec_slot (decl_specializations, tmpl,
+					  TREE_PURPOSE (head), hash);
+	      if (head_slot)
+		head_entry = *head_slot;
+	    }
+	  if (!entry->shadowed
+	      && (node == head
+		  || (head_entry && head_entry->node == head
+		      && !head_entry->shadowed)))
+	    {
+	      htab_clear_slot (decl_specializations, slot);
+	      if (node != head)
+		{
+		  TREE_PURPOSE (node) = TREE_PURPOSE (head);
+		  TREE_VALUE (node) = TREE_VALUE (head);
+		  TREE_TYPE (node) = TREE_TYPE (head);
+		  head_entry->node = node;
+		}
+	      DECL_TEMPLATE_SPECIALIZATIONS (tmpl) = TREE_CHAIN (head);
+	      return 1;
+	    }
+	}
+    }
+
   for (s = &DECL_TEMPLATE_SPECIALIZATIONS (tmpl);
        *s != NULL_TREE;
        s = &TREE_CHAIN (*s))
     if (TREE_VALUE (*s) == spec)
       {
 	if (!new_spec)
-	  *s = TREE_CHAIN (*s);
+	  {
+	    tree node = *s;
+
+	    *s = TREE_CHAIN (*s);
+	    remove_template_list_node (decl_specializations, tmpl, *s, node);
+	  }
 	else
 	  TREE_VALUE (*s) = new_spec;
 	return 1;
@@ -1196,6 +1706,57 @@ hash_local_specialization (const void* p1)
   return htab_hash_pointer (TREE_VALUE ((tree) p1));
 }
 
+/* Hash P, an entry in the TSUBST_AGGR_MEMO table.  */
+
+static hashval_t
+hash_tsubst_aggr_entry (const void *p)
+{
+  const struct tsubst_aggr_entry *e = p;
+
+  return (htab_hash_pointer (e->t)
+	  ^ (htab_hash_pointer (e->args) * 31)
+	  ^ (e->template_depth * 4 + e->entering_scope * 2));
+}
+
+/* Compare two entries in the TSUBST_AGGR_MEMO table.  */
+
+static int
+eq_tsubst_aggr_entry (const void *p1, const void *p2)
+{
+  const struct tsubst_aggr_entry *e1 = p1;
+  const struct tsubst_aggr_entry *e2 = p2;
+
+  return (e1->t == e2->t
+	  && e1->args == e2->args
+	  && e1->complain == e2->complain
+	  && e1->entering_scope == e2->entering_scope
+	  && e1->template_depth == e2->template_depth);
+}
+
+/* Start remembering the results of tsubst_aggr_type for a new
+   instantiation.  Returns the table for the enclosing one, which
+   should be passed to pop_tsubst_aggr_memo when done.  */
+
+static htab_t
+push_tsubst_aggr_memo (void)
+{
+  htab_t saved = tsubst_aggr_memo;
+
+  tsubst_aggr_memo = htab_create (37, hash_tsubst_aggr_entry,
+				  eq_tsubst_aggr_entry, free);
+  return saved;
+}
+
+/* Forget the results remembered since the matching call to
+   push_tsubst_aggr_memo, which returned SAVED.  */
+
+static void
+pop_tsubst_aggr_memo (htab_t saved)
+{
+  htab_delete (tsubst_aggr_memo);
+  tsubst_aggr_memo = saved;
+}
+
 /* Like register_specialization, but for local declarations.  We are
    registering SPEC, an instantiation of TMPL.  */
 
@@ -2437,6 +2998,7 @@ process_partial_specialization (tree decl)
   int nargs = TREE_VEC_LENGTH (inner_args);
   int ntparms = TREE_VEC_LENGTH (inner_parms);
   int  i;
+  bool unhashable;
   int did_error_intro = 0;
   struct template_parm_data tpd;
   struct template_parm_data tpd2;
@@ -2595,6 +3157,11 @@ process_partial_specialization (tree decl)
     = tree_cons (inner_args, inner_parms,
 		 DECL_TEMPLATE_SPECIALIZATIONS (maintmpl));
   TREE_TYPE (DECL_TEMPLATE_SPECIALIZATIONS (maintmpl)) = type;
+  add_template_list_node (&decl_specializations, maintmpl,
+			  DECL_TEMPLATE_SPECIALIZATIONS (maintmpl),
+			  /*at_front=*/true,
+			  hash_tmpl_and_args (maintmpl, inner_args,
+					      &unhashable));
   return decl;
 }
 
@@ -4263,10 +4830,11 @@ lookup_template_class (tree d1,
       tree gen_tmpl;
       tree type_decl;
       tree found = NULL_TREE;
-      tree *tp;
       int arg_depth;
       int parm_depth;
       int is_partial_instantiation;
+      hashval_t hash;
+      bool unhashable;
 
       gen_tmpl = most_general_template (template);
       parmlist = DECL_TEMPLATE_PARMS (gen_tmpl);
@@ -4387,22 +4955,12 @@ lookup_template_class (tree d1,
       if (found)
         POP_TIMEVAR_AND_RETURN (TV_NAME_LOOKUP, found);
 
-      for (tp = &DECL_TEMPLATE_INSTANTIATIONS (template);
-	   *tp;
-	   tp = &TREE_CHAIN (*tp))
-	if (comp_template_args (TREE_PURPOSE (*tp), arglist))
-	  {
-	    found = *tp;
-
-	    /* Use the move-to-front heuristic to speed up future
-	       searches.  */
-	    *tp = TREE_CHAIN (*tp);
-	    TREE_CHAIN (found) 
-	      = DECL_TEMPLATE_INSTANTIATIONS (template);
-	    DECL_TEMPLATE_INSTANTIATIONS (template) = found;
-
-	    POP_TIMEVAR_AND_RETURN (TV_NAME_LOOKUP, TREE_VALUE (found));
-	  }
+      hash = hash_tmpl_and_args (template, arglist, &unhashable);
+      found = lookup_template_list_node (class_instantiations, template,
+					 DECL_TEMPLATE_INSTANTIATIONS (template),
+					 arglist, hash, unhashable);
+      if (found)
+	POP_TIMEVAR_AND_RETURN (TV_NAME_LOOKUP, TREE_VALUE (found));
 
       /* This type is a "partial instantiation" if any of the template
 	 arguments still involve template parameters.  Note that we set
@@ -4547,6 +5105,9 @@ lookup_template_class (tree d1,
       DECL_TEMPLATE_INSTANTIATIONS (template) 
 	= tree_cons (arglist, t, 
 		     DECL_TEMPLATE_INSTANTIATIONS (template));
+      add_template_list_node (&class_instantiations, template,
+			      DECL_TEMPLATE_INSTANTIATIONS (template),
+			      /*at_front=*/true, hash);
 
       if (TREE_CODE (t) == ENUMERAL_TYPE 
 	  && !is_partial_instantiation)
@@ -5129,9 +5690,7 @@ tsubst_friend_function (tree decl, tree args)
 		  t = most_general_template (old_decl);
 		  if (t != old_decl)
 		    {
-		      DECL_TEMPLATE_SPECIALIZATIONS (t)
-			= chainon (DECL_TEMPLATE_SPECIALIZATIONS (t),
-				   DECL_TEMPLATE_SPECIALIZATIONS (old_decl));
+		      merge_specializations (t, old_decl);
 		      DECL_TEMPLATE_SPECIALIZATIONS (old_decl) = NULL_TREE;
 		    }
 		}
@@ -5277,6 +5836,7 @@ instantiate_class_template (tree type)
   tree template, args, pattern, t, member;
   tree typedecl;
   tree pbinfo;
+  htab_t saved_tsubst_aggr_memo;
   
   if (type == error_mark_node)
     return error_mark_node;
@@ -5461,6 +6021,7 @@ instantiate_class_template (tree type)
      begin_class_definition when defining an ordinary non-template
      class.  */
   pushclass (type);
+  saved_tsubst_aggr_memo = push_tsubst_aggr_memo ();
 
   /* Now members are processed in the order of declaration.  */
   for (member = CLASSTYPE_DECL_LIST (pattern);
@@ -5686,6 +6247,7 @@ instantiate_class_template (tree type)
 	  && DECL_TEMPLATE_INFO (t))
 	tsubst_default_arguments (t);
 
+  pop_tsubst_aggr_memo (saved_tsubst_aggr_memo);
   popclass ();
   pop_from_top_level ();
   pop_deferring_access_checks ();
@@ -5859,6 +6421,26 @@ tsubst_aggr_type (tree t,
 	  tree argvec;
 	  tree context;
 	  tree r;
+	  struct tsubst_aggr_entry key;
+	  struct tsubst_aggr_entry *entry;
+	  bool memo_p;
+
+	  /* See if we have already done this substitution during the
+	     current instantiation.  Speculative substitutions, as
+	     during deduction, are not remembered, as their arguments
+	     may still be filled in.  */
+	  memo_p = tsubst_aggr_memo && (complain & tf_error);
+	  if (memo_p)
+	    {
+	      key.t = t;
+	      key.args = args;
+	      key.complain = complain;
+	      key.entering_scope = entering_scope;
+	      key.template_depth = processing_template_decl;
+	      entry = htab_find (tsubst_aggr_memo, &key);
+	      if (entry)
+		return entry->r;
+	    }
 
 	  /* First, determine the context for the type we are looking
 	     up.  */
@@ -5884,7 +6466,15 @@ tsubst_aggr_type (tree t,
   	  r = lookup_template_class (t, argvec, in_decl, context,
 				     entering_scope, complain);
 
-	  return cp_build_qualified_type_real (r, TYPE_QUALS (t), complain);
+	  r = cp_build_qualified_type_real (r, TYPE_QUALS (t), complain);
+	  if (memo_p && r != error_mark_node)
+	    {
+	      entry = xmalloc (sizeof (struct tsubst_aggr_entry));
+	      *entry = key;
+	      entry->r = r;
+	      *htab_find_slot (tsubst_aggr_memo, entry, INSERT) = entry;
+	    }
+	  return r;
 	}
       else 
 	/* This is not a template type, so there's nothing to do.  */
@@ -11318,6 +11908,7 @@ instantiate_decl (tree d, int defer_ok)
   else if (TREE_CODE (d) == FUNCTION_DECL)
     {
       htab_t saved_local_specializations;
+      htab_t saved_tsubst_aggr_memo;
       tree subst_decl;
       tree tmpl_parm;
       tree spec_parm;
@@ -11359,8 +11950,10 @@ instantiate_decl (tree d, int defer_ok)
       my_friendly_assert (!spec_parm, 20020813);
 
       /* Substitute into the body of the function.  */
+      saved_tsubst_aggr_memo = push_tsubst_aggr_memo ();
       tsubst_expr (DECL_SAVED_TREE (code_pattern), args,
 		   tf_error | tf_warning, tmpl);
+      pop_tsubst_aggr_memo (saved_tsubst_aggr_memo);
 
       /* We don't need the local specializations any more.  */
       htab_delete (local_specializations);
@@ -108,6 +108,8 @@ static int friend_accessible_p (tree, tree, tree);
 static void setup_class_bindings (tree, int);
 static int template_self_reference_p (tree, tree);
 static tree dfs_get_pure_virtuals (tree, void *);
+static hashval_t hash_member_lookup (const void *);
+static int eq_member_lookup (const void *, const void *);
 
 /* Allocate a level of searching.  */
 
@@ -1033,6 +1035,57 @@ struct lookup_field_info {
   const char *errstr;
 };
 
+/* The result of looking up NAME in the complete class TYPE, without
+   regard to access.  The members of a class do not change once it is
+   complete, so the walk over its bases is done only once.  */
+
+struct member_lookup_entry GTY(())
+{
+  tree type;
+  tree name;
+  /* The LOOKUP_FIELD_INFO fields recording the result.  */
+  tree rval;
+  tree rval_binfo;
+  hashval_t hash;
+  unsigned char want_type;
+};
+
+/* Table of struct member_lookup_entry.  */
+
+static GTY ((param_is (struct member_lookup_entry))) htab_t member_lookups;
+
+/* Hash P, a struct member_lookup_entry.  */
+
+static hashval_t
+hash_member_lookup (const void *p)
+{
+  return ((const struct member_lookup_entry *) p)->hash;
+}
+
+/* Compare the struct member_lookup_entry P1 with the key P2.  */
+
+static int
+eq_member_lookup (const void *p1, const void *p2)
+{
+  const struct member_lookup_entry *e1 = p1;
+  const struct member_lookup_entry *e2 = p2;
+
+  return (e1->type == e2->type
+	  && e1->name == e2->name
+	  && e1->want_type == e2->want_type);
+}
+
+/* Forget all the member lookups remembered by lookup_member.  This
+   must be done if a member is added to a class after it is
+   complete.  */
+
+void
+clear_member_lookups (void)
+{
+  if (member_lookups)
+    htab_empty (member_lookups);
+}
+
 /* Returns nonzero if BINFO is not hidden by the value found by the
    lookup so far.  If BINFO is hidden, then there's no need to look in
    it.  DATA is really a struct lookup_field_info.  Called from
@@ -1278,6 +1331,8 @@ lookup_member (tree xbasetype, tree name, int protect, bool want_type)
   tree rval, rval_binfo = NULL_TREE;
   tree type = NULL_TREE, basetype_path = NULL_TREE;
   struct lookup_field_info lfi;
+  struct member_lookup_entry key;
+  struct member_lookup_entry *entry = NULL;
 
   /* rval_binfo is the binfo associated with the found member, note,
      this can be set with useful information, even when rval is not
@@ -1324,7 +1379,48 @@ lookup_member (tree xbasetype, tree name, int protect, bool want_type)
   lfi.type = type;
   lfi.name = name;
   lfi.want_type = want_type;
-  bfs_walk (basetype_path, &lookup_field_r, &lookup_field_queue_p, &lfi);
+
+  /* The lookup does not depend on where we are, so if the whole
+     lattice is being searched its result can be reused.  */
+  key.type = NULL_TREE;
+  if (COMPLETE_TYPE_P (type) && !TYPE_BEING_DEFINED (type)
+      && basetype_path == TYPE_BINFO (type))
+    {
+      key.type = type;
+      key.name = name;
+      key.want_type = want_type;
+      key.hash = ((TYPE_UID (type) * 2 + want_type)
+		  ^ IDENTIFIER_HASH_VALUE (name));
+      if (member_lookups)
+	entry = htab_find_with_hash (member_lookups, &key, key.hash);
+    }
+
+  if (entry)
+    {
+      lfi.rval = entry->rval;
+      lfi.rval_binfo = entry->rval_binfo;
+    }
+  else
+    {
+      bfs_walk (basetype_path, &lookup_field_r, &lookup_field_queue_p, &lfi);
+      /* Ambiguous lookups are rare, and are not remembered so that
+	 the list of candidates is built afresh each time.  */
+      if (key.type && !lfi.ambiguous)
+	{
+	  void **slot;
+
+	  if (!member_lookups)
+	    member_lookups = htab_create_ggc (37, hash_member_lookup,
+					      eq_member_lookup, NULL);
+	  slot = htab_find_slot_with_hash (member_lookups, &key, key.hash,
+					   INSERT);
+	  entry = ggc_alloc (sizeof (struct member_lookup_entry));
+	  *entry = key;
+	  entry->rval = lfi.rval;
+	  entry->rval_binfo = lfi.rval_binfo;
+	  *slot = entry;
+	}
+    }
   rval = lfi.rval;
   rval_binfo = lfi.rval_binfo;
   if (rval_binfo)
@@ -2645,3 +2741,4 @@ original_binfo (tree binfo, tree here)
   return result;
 }
 
+#include "gt-cp-search.h"
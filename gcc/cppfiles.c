@@ -175,10 +175,18 @@ static struct file_hash_entry *new_file_hash_entry (cpp_reader *pfile);
 static int report_missing_guard (void **slot, void *b);
 static hashval_t file_hash_hash (const void *p);
 static int file_hash_eq (const void *p, const void *q);
+static hashval_t path_hash_hash (const void *p);
+static int path_hash_eq (const void *p, const void *q);
 static char *read_filename_string (int ch, FILE *f);
 static void read_name_map (cpp_dir *dir);
 static char *remap_filename (cpp_reader *pfile, _cpp_file *file);
 static char *append_file_to_dir (const char *fname, cpp_dir *dir);
+static hashval_t dir_entry_hash (const void *p);
+static int dir_entry_eq (const void *p, const void *q);
+static void read_dir_entries (cpp_dir *dir);
+static bool dir_entry_maybe_present_p (cpp_dir *dir, const char *name);
+static bool file_absent_p (cpp_reader *pfile, cpp_dir *dir,
+			   const char *fname);
 static bool validate_pch (cpp_reader *, _cpp_file *file, const char *pchname);
 static bool include_pch_p (_cpp_file *file);
 
@@ -318,6 +326,12 @@ find_file_in_dir (cpp_reader *pfile, _cpp_file *file, bool *invalid_pch)
 
   if (CPP_OPTION (pfile, remap) && (path = remap_filename (pfile, file)))
     ;
+  else if (file_absent_p (pfile, file->dir, file->name))
+    {
+      file->path = file->name;
+      file->err_no = ENOENT;
+      return false;
+    }
   else
     path = append_file_to_dir (file->name, file->dir);
 
@@ -567,10 +581,28 @@ should_stack_file (cpp_reader *pfile, _cpp_file *file, bool import)
 	return false;
     }
 
+  /* A file not yet stacked under this name may still have been
+     stacked from the same path under another.  If so, its header
+     guard is the same.  */
+  if (file->cmacro == NULL && file->stack_count == 0 && file->path[0])
+    {
+      f = htab_find_with_hash (pfile->path_hash, file->path,
+			       htab_hash_string (file->path));
+      if (f != NULL)
+	file->cmacro = f->cmacro;
+    }
+
   /* Skip if the file had a header guard and the macro is defined.
      PCH relies on this appearing before the PCH handler below.  */
   if (file->cmacro && file->cmacro->type == NT_MACRO)
-    return false;
+    {
+      if (file->fd != -1)
+	{
+	  close (file->fd);
+	  file->fd = -1;
+	}
+      return false;
+    }
 
   /* Handle PCH files immediately; don't stack them.  */
   if (include_pch_p (file))
@@ -659,6 +691,16 @@ _cpp_stack_file (cpp_reader *pfile, _cpp_file *file, bool import)
 	deps_add_dep (pfile->deps, file->path);
     }
 
+  /* Remember the first file stacked from this path.  */
+  if (file->path[0])
+    {
+      void **slot = htab_find_slot_with_hash (pfile->path_hash, file->path,
+					      htab_hash_string (file->path),
+					      INSERT);
+      if (*slot == NULL)
+	*slot = file;
+    }
+
   /* Clear buffer_valid since _cpp_clean_line messes it up.  */
   file->buffer_valid = false;
   file->stack_count++;
@@ -926,6 +968,20 @@ file_hash_eq (const void *p, const void *q)
   return strcmp (hname, fname) == 0;
 }
 
+/* Hash a _cpp_file P by its path.  */
+static hashval_t
+path_hash_hash (const void *p)
+{
+  return htab_hash_string (((_cpp_file *) p)->path);
+}
+
+/* Compare a path Q against the path of _cpp_file P.  */
+static int
+path_hash_eq (const void *p, const void *q)
+{
+  return strcmp (((_cpp_file *) p)->path, (const char *) q) == 0;
+}
+
 /* Initialize everything in this source file.  */
 void
 _cpp_init_files (cpp_reader *pfile)
@@ -934,6 +990,8 @@ _cpp_init_files (cpp_reader *pfile)
 					NULL, xcalloc, free);
   pfile->dir_hash = htab_create_alloc (127, file_hash_hash, file_hash_eq,
 					NULL, xcalloc, free);
+  pfile->path_hash = htab_create_alloc (127, path_hash_hash, path_hash_eq,
+					NULL, xcalloc, free);
   allocate_file_hash_entries (pfile);
 }
 
@@ -943,6 +1001,7 @@ _cpp_cleanup_files (cpp_reader *pfile)
 {
   htab_delete (pfile->file_hash);
   htab_delete (pfile->dir_hash);
+  htab_delete (pfile->path_hash);
 }
 
 /* Enter a file name in the hash for the sake of cpp_included.  */
@@ -1091,6 +1150,8 @@ cpp_set_include_chains (cpp_reader *pfile, cpp_dir *quote, cpp_dir *bracket,
   for (; quote; quote = quote->next)
     {
       quote->name_map = NULL;
+      quote->entries = NULL;
+      quote->entries_unreadable = 0;
       quote->len = strlen (quote->name);
       if (quote == bracket)
 	pfile->bracket_include = bracket;
@@ -1116,6 +1177,129 @@ append_file_to_dir (const char *fname, cpp_dir *dir)
   return path;
 }
 
+/* Hash and comparison callbacks for the table of a directory's
+   entries.  Names are compared without regard to case, since the file
+   system may not regard it either; a false match merely costs a system
+   call.  */
+static hashval_t
+dir_entry_hash (const void *p)
+{
+  const uchar *name = p;
+  hashval_t r = 0;
+
+  while (*name)
+    r = r * 67 + TOLOWER (*name++) - 113;
+
+  return r;
+}
+
+static int
+dir_entry_eq (const void *p, const void *q)
+{
+  const uchar *a = p, *b = q;
+
+  while (*a && TOLOWER (*a) == TOLOWER (*b))
+    a++, b++;
+
+  return TOLOWER (*a) == TOLOWER (*b);
+}
+
+/* Read the names of the entries in DIR into DIR->entries.  A directory
+   that does not exist has no entries.  If it exists but cannot be
+   listed, perhaps because it is searchable but not readable, set
+   DIR->entries_unreadable instead.  */
+static void
+read_dir_entries (cpp_dir *dir)
+{
+  DIR *d;
+  struct dirent *ent;
+
+  d = opendir (dir->name);
+  if (d == NULL && errno != ENOENT && errno != ENOTDIR)
+    {
+      dir->entries_unreadable = 1;
+      return;
+    }
+
+  dir->entries = htab_create (16, dir_entry_hash, dir_entry_eq, free);
+  if (d == NULL)
+    return;
+
+  while ((ent = readdir (d)) != NULL)
+    {
+      void **slot = htab_find_slot (dir->entries, ent->d_name, INSERT);
+
+      if (*slot == NULL)
+	*slot = xstrdup (ent->d_name);
+    }
+
+  closedir (d);
+}
+
+/* Return false if DIR certainly has no entry called NAME.  Names with
+   characters outside ASCII are always assumed to be present, as the
+   file system may store them in a different normalization.  */
+static bool
+dir_entry_maybe_present_p (cpp_dir *dir, const char *name)
+{
+  const char *p;
+
+  for (p = name; *p; p++)
+    if (*(const uchar *) p >= 0x80)
+      return true;
+
+  return htab_find (dir->entries, name) != NULL;
+}
+
+/* Return true if there is certainly no file FNAME in DIR, nor a
+   precompiled header that could stand in for it, so that looking for
+   it need not involve the operating system.  Only the first component
+   of FNAME is checked; that is enough to rule out most of the misses
+   when searching a long include path.  */
+static bool
+file_absent_p (cpp_reader *pfile, cpp_dir *dir, const char *fname)
+{
+#if defined (HAVE_DOS_BASED_FILE_SYSTEM) || defined (VMS)
+  return false;
+#else
+  const char *slash;
+  char *name;
+  size_t len;
+
+  if (dir->len == 0 || dir->entries_unreadable)
+    return false;
+
+  slash = strchr (fname, '/');
+  len = slash ? (size_t) (slash - fname) : strlen (fname);
+  if (len == 0 || (fname[0] == '.' && (len == 1
+				       || (len == 2 && fname[1] == '.'))))
+    return false;
+
+  if (dir->entries == NULL)
+    {
+      read_dir_entries (dir);
+      if (dir->entries_unreadable)
+	return false;
+    }
+
+  name = alloca (len + sizeof (".gch"));
+  memcpy (name, fname, len);
+  name[len] = '\0';
+  if (dir_entry_maybe_present_p (dir, name))
+    return false;
+
+  /* pch_open_file looks for FNAME.gch before FNAME itself.  */
+  if (slash == NULL && pfile->cb.valid_pch)
+    {
+      strcpy (name + len, ".gch");
+      if (dir_entry_maybe_present_p (dir, name))
+	return false;
+    }
+
+  return true;
+#endif
+}
+
 /* Read a space delimited string of unlimited length from a stdio
    file F.  */
 static char *
@@ -366,6 +366,11 @@ struct cpp_reader
   struct file_hash_entry *file_hash_entries;
   unsigned int file_hash_entries_allocated, file_hash_entries_used;
 
+  /* The first _cpp_file stacked from each path, so that a file
+     reached again under a different name or from a different
+     directory can use what is already known of its guard macro.  */
+  struct htab *path_hash;
+
   /* Nonzero means don't look for #include "foo" the source-file
      directory.  */
   bool quote_ignores_source_dir;
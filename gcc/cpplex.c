@@ -97,6 +97,41 @@ add_line_note (cpp_buffer *buffer, const uchar *pos, unsigned int type)
   buffer->notes_used++;
 }
 
+/* The fast paths below look for a few interesting characters in long
+   runs of uninteresting ones, so they examine a word of the buffer at
+   a time.  WORD_HAS_BYTE is nonzero if any byte of word X equals C;
+   it may not say which one, but it never misses one.  */
+typedef unsigned long word_type;
+#define WORD_ONES ((word_type) -1 / 0xff)
+#define WORD_HAS_ZERO(X) (((X) - WORD_ONES) & ~(X) & (WORD_ONES << 7))
+#define WORD_HAS_BYTE(X, C) WORD_HAS_ZERO ((X) ^ (WORD_ONES * (uchar) (C)))
+
+/* Return a pointer to the first of the characters C1, C2 or C3 at or
+   after S.  LIMIT is the end of the buffer; the caller guarantees that
+   one of the characters occurs at or before it, and nothing beyond it
+   is read.  */
+static inline const uchar *
+search_chars (const uchar *s, const uchar *limit, uchar c1, uchar c2,
+	      uchar c3)
+{
+  while (s + sizeof (word_type) <= limit)
+    {
+      word_type w;
+
+      /* S need not be aligned; let the compiler pick the best way to
+	 load the word.  */
+      memcpy (&w, s, sizeof (word_type));
+      if (WORD_HAS_BYTE (w, c1) | WORD_HAS_BYTE (w, c2)
+	  | WORD_HAS_BYTE (w, c3))
+	break;
+      s += sizeof (word_type);
+    }
+
+  while (*s != c1 && *s != c2 && *s != c3)
+    s++;
+  return s;
+}
+
 /* Returns with a logical line that contains no escaped newlines or
    trigraphs.  This is a time-critical inner loop.  */
 void
@@ -119,7 +154,8 @@ _cpp_clean_line (cpp_reader *pfile)
 	 data back to memory until we have to.  */
       for (;;)
 	{
-	  c = *++s;
+	  s = search_chars (s + 1, buffer->rlimit, '\n', '\r', '?');
+	  c = *s;
 	  if (c == '\n' || c == '\r')
 	    {
 	      d = (uchar *) s;
@@ -328,6 +364,7 @@ _cpp_skip_block_comment (cpp_reader *pfile)
     {
       /* People like decorating comments with '*', so check for '/'
 	 instead for efficiency.  */
+      cur = search_chars (cur, buffer->rlimit, '/', '\n', '\n');
       c = *cur++;
 
       if (c == '/')
@@ -373,8 +410,8 @@ skip_line_comment (cpp_reader *pfile)
   cpp_buffer *buffer = pfile->buffer;
   unsigned int orig_line = pfile->line;
 
-  while (*buffer->cur != '\n')
-    buffer->cur++;
+  buffer->cur = search_chars (buffer->cur, buffer->rlimit,
+			     '\n', '\n', '\n');
 
   _cpp_process_line_notes (pfile, true);
   return orig_line != pfile->line;
@@ -467,21 +504,31 @@ lex_identifier (cpp_reader *pfile, const uchar *base)
 {
   cpp_hashnode *result;
   const uchar *cur;
+  unsigned int hash = 0;
 
+  /* Hash the identifier as we find its end, rather than making
+     ht_lookup go over it again.  */
+  cur = base;
   do
     {
-      cur = pfile->buffer->cur;
+      /* Whatever forms_identifier_p accepted.  */
+      while (cur < pfile->buffer->cur)
+	hash = HT_HASHSTEP (hash, *cur++);
 
       /* N.B. ISIDNUM does not include $.  */
       while (ISIDNUM (*cur))
-	cur++;
+	{
+	  hash = HT_HASHSTEP (hash, *cur);
+	  cur++;
+	}
 
       pfile->buffer->cur = cur;
     }
   while (forms_identifier_p (pfile, false));
 
   result = (cpp_hashnode *)
-    ht_lookup (pfile->hash_table, base, cur - base, HT_ALLOC);
+    ht_lookup_with_hash (pfile->hash_table, base, cur - base,
+			 HT_HASHFINISH (hash, cur - base), HT_ALLOC);
 
   /* Rarely, identifiers require diagnostics when lexed.  */
   if (__builtin_expect ((result->flags & NODE_DIAGNOSTIC)
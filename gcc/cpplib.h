@@ -422,6 +422,15 @@ struct cpp_dir
      platforms.  A NULL-terminated array of (from, to) pairs.  */
   const char **name_map;
 
+  /* The names of the entries in this directory, read once so that
+     lookups of names that are not there need no system calls.  NULL
+     until first needed; see read_dir_entries in cppfiles.c.  */
+  struct htab *entries;
+
+  /* Nonzero if the directory could not be listed, so ENTRIES cannot
+     rule anything out.  */
+  unsigned char entries_unreadable;
+
   /* The C front end uses these to recognize duplicated
      directories in the search path.  */
   ino_t INO_CPP;
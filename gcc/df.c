@@ -289,16 +289,8 @@ static void df_ru_transfer_function (int, int *, bitmap, bitmap, bitmap,
 				     bitmap, void *);
 static void df_lr_transfer_function (int, int *, bitmap, bitmap, bitmap,
 				     bitmap, void *);
-static void hybrid_search_bitmap (basic_block, bitmap *, bitmap *,
-				  bitmap *, bitmap *, enum df_flow_dir,
-				  enum df_confluence_op,
-				  transfer_function_bitmap,
-				  sbitmap, sbitmap, void *);
-static void hybrid_search_sbitmap (basic_block, sbitmap *, sbitmap *,
-				   sbitmap *, sbitmap *, enum df_flow_dir,
-				   enum df_confluence_op,
-				   transfer_function_sbitmap,
-				   sbitmap, sbitmap, void *);
+static void df_worklist_add_deps (basic_block, enum df_flow_dir, int *,
+				  fibheap_t, sbitmap);
 
 
 /* Local memory allocation/deallocation routines.  */
@@ -1928,9 +1920,11 @@ df_analyse_1 (struct df *df, bitmap blocks, int flags, int update)
 	    gen[bb->index] = DF_BB_INFO (df, bb)->rd_gen;
 	    kill[bb->index] = DF_BB_INFO (df, bb)->rd_kill;
 	  }
-	iterative_dataflow_bitmap (in, out, gen, kill, df->all_blocks,
-				   DF_FORWARD, DF_UNION, df_rd_transfer_function,
-				   df->inverse_rc_map, NULL);
+	df->rd_visits
+	  = iterative_dataflow_bitmap (in, out, gen, kill, df->all_blocks,
+				       DF_FORWARD, DF_UNION,
+				       df_rd_transfer_function,
+				       df->inverse_rc_map, NULL);
 	free (in);
 	free (out);
 	free (gen);
@@ -1964,9 +1958,11 @@ df_analyse_1 (struct df *df, bitmap blocks, int flags, int update)
 	    gen[bb->index] = DF_BB_INFO (df, bb)->ru_gen;
 	    kill[bb->index] = DF_BB_INFO (df, bb)->ru_kill;
 	  }
-	iterative_dataflow_bitmap (in, out, gen, kill, df->all_blocks,
-				   DF_BACKWARD, DF_UNION, df_ru_transfer_function,
-				   df->inverse_rts_map, NULL);
+	df->ru_visits
+	  = iterative_dataflow_bitmap (in, out, gen, kill, df->all_blocks,
+				       DF_BACKWARD, DF_UNION,
+				       df_ru_transfer_function,
+				       df->inverse_rts_map, NULL);
 	free (in);
 	free (out);
 	free (gen);
@@ -2003,9 +1999,11 @@ df_analyse_1 (struct df *df, bitmap blocks, int flags, int update)
 	    use[bb->index] = DF_BB_INFO (df, bb)->lr_use;
 	    def[bb->index] = DF_BB_INFO (df, bb)->lr_def;
 	  }
-	iterative_dataflow_bitmap (in, out, use, def, df->all_blocks,
-				   DF_BACKWARD, DF_UNION, df_lr_transfer_function,
-				   df->inverse_rts_map, NULL);
+	df->lr_visits
+	  = iterative_dataflow_bitmap (in, out, use, def, df->all_blocks,
+				       DF_BACKWARD, DF_UNION,
+				       df_lr_transfer_function,
+				       df->inverse_rts_map, NULL);
 	free (in);
 	free (out);
 	free (use);
@@ -3050,6 +3048,8 @@ df_dump (struct df *df, int flags, FILE *file)
   fprintf (file, "\nDataflow summary:\n");
   fprintf (file, "n_regs = %d, n_defs = %d, n_uses = %d, n_bbs = %d\n",
 	   df->n_regs, df->n_defs, df->n_uses, df->n_bbs);
+  fprintf (file, "blocks evaluated: rd = %u, ru = %u, lr = %u\n",
+	   df->rd_visits, df->ru_visits, df->lr_visits);
 
   if (flags & DF_RD)
     {
@@ -3344,214 +3344,36 @@ debug_df_chain (struct df_link *link)
 }
 
 
-/* Hybrid search algorithm from "Implementation Techniques for
-   Efficient Data-Flow Analysis of Large Programs".  */
+/* Make the blocks that depend on the result for block BB pending again,
+   inserting them into WORKLIST with their ORDER as priority.  Those are
+   the successors of BB for a forward problem and its predecessors for a
+   backward one.  */
 static void
-hybrid_search_bitmap (basic_block block, bitmap *in, bitmap *out, bitmap *gen,
-		      bitmap *kill, enum df_flow_dir dir,
-		      enum df_confluence_op conf_op,
-		      transfer_function_bitmap transfun, sbitmap visited,
-		      sbitmap pending, void *data)
-{
-  int changed;
-  int i = block->index;
+df_worklist_add_deps (basic_block bb, enum df_flow_dir dir, int *order,
+		      fibheap_t worklist, sbitmap pending)
+{
   edge e;
-  basic_block bb = block;
 
-  SET_BIT (visited, block->index);
-  if (TEST_BIT (pending, block->index))
-    {
-      if (dir == DF_FORWARD)
-	{
-	  /*  Calculate <conf_op> of predecessor_outs.  */
-	  bitmap_zero (in[i]);
-	  for (e = bb->pred; e != 0; e = e->pred_next)
-	    {
-	      if (e->src == ENTRY_BLOCK_PTR)
-		continue;
-	      switch (conf_op)
-		{
-		case DF_UNION:
-		  bitmap_a_or_b (in[i], in[i], out[e->src->index]);
-		  break;
-		case DF_INTERSECTION:
-		  bitmap_a_and_b (in[i], in[i], out[e->src->index]);
-		  break;
-		}
-	    }
-	}
-      else
-	{
-	  /* Calculate <conf_op> of successor ins.  */
-	  bitmap_zero (out[i]);
-	  for (e = bb->succ; e != 0; e = e->succ_next)
-	    {
-	      if (e->dest == EXIT_BLOCK_PTR)
-		continue;
-	      switch (conf_op)
-		{
-		case DF_UNION:
-		  bitmap_a_or_b (out[i], out[i], in[e->dest->index]);
-		  break;
-		case DF_INTERSECTION:
-		  bitmap_a_and_b (out[i], out[i], in[e->dest->index]);
-		  break;
-		}
-	    }
-	}
-      /* Common part */
-      (*transfun)(i, &changed, in[i], out[i], gen[i], kill[i], data);
-      RESET_BIT (pending, i);
-      if (changed)
-	{
-	  if (dir == DF_FORWARD)
-	    {
-	      for (e = bb->succ; e != 0; e = e->succ_next)
-		{
-		  if (e->dest == EXIT_BLOCK_PTR || e->dest->index == i)
-		    continue;
-		  SET_BIT (pending, e->dest->index);
-		}
-	    }
-	  else
-	    {
-	      for (e = bb->pred; e != 0; e = e->pred_next)
-		{
-		  if (e->src == ENTRY_BLOCK_PTR || e->dest->index == i)
-		    continue;
-		  SET_BIT (pending, e->src->index);
-		}
-	    }
-	}
-    }
   if (dir == DF_FORWARD)
     {
       for (e = bb->succ; e != 0; e = e->succ_next)
 	{
-	  if (e->dest == EXIT_BLOCK_PTR || e->dest->index == i)
+	  if (e->dest == EXIT_BLOCK_PTR || TEST_BIT (pending, e->dest->index))
 	    continue;
-	  if (!TEST_BIT (visited, e->dest->index))
-	    hybrid_search_bitmap (e->dest, in, out, gen, kill, dir,
-				  conf_op, transfun, visited, pending,
-				  data);
+	  SET_BIT (pending, e->dest->index);
+	  fibheap_insert (worklist, order[e->dest->index],
+			  (void *) (size_t) e->dest->index);
 	}
     }
   else
     {
       for (e = bb->pred; e != 0; e = e->pred_next)
 	{
-	  if (e->src == ENTRY_BLOCK_PTR || e->src->index == i)
+	  if (e->src == ENTRY_BLOCK_PTR || TEST_BIT (pending, e->src->index))
 	    continue;
-	  if (!TEST_BIT (visited, e->src->index))
-	    hybrid_search_bitmap (e->src, in, out, gen, kill, dir,
-				  conf_op, transfun, visited, pending,
-				  data);
-	}
-    }
-}
-
-
-/* Hybrid search for sbitmaps, rather than bitmaps.  */
-static void
-hybrid_search_sbitmap (basic_block block, sbitmap *in, sbitmap *out,
-		       sbitmap *gen, sbitmap *kill, enum df_flow_dir dir,
-		       enum df_confluence_op conf_op,
-		       transfer_function_sbitmap transfun, sbitmap visited,
-		       sbitmap pending, void *data)
-{
-  int changed;
-  int i = block->index;
-  edge e;
-  basic_block bb = block;
-
-  SET_BIT (visited, block->index);
-  if (TEST_BIT (pending, block->index))
-    {
-      if (dir == DF_FORWARD)
-	{
-	  /* Calculate <conf_op> of predecessor_outs.  */
-	  sbitmap_zero (in[i]);
-	  for (e = bb->pred; e != 0; e = e->pred_next)
-	    {
-	      if (e->src == ENTRY_BLOCK_PTR)
-		continue;
-	      switch (conf_op)
-		{
-		case DF_UNION:
-		  sbitmap_a_or_b (in[i], in[i], out[e->src->index]);
-		  break;
-		case DF_INTERSECTION:
-		  sbitmap_a_and_b (in[i], in[i], out[e->src->index]);
-		  break;
-		}
-	    }
-	}
-      else
-	{
-	  /* Calculate <conf_op> of successor ins.  */
-	  sbitmap_zero (out[i]);
-	  for (e = bb->succ; e != 0; e = e->succ_next)
-	    {
-	      if (e->dest == EXIT_BLOCK_PTR)
-		continue;
-	      switch (conf_op)
-		{
-		case DF_UNION:
-		  sbitmap_a_or_b (out[i], out[i], in[e->dest->index]);
-		  break;
-		case DF_INTERSECTION:
-		  sbitmap_a_and_b (out[i], out[i], in[e->dest->index]);
-		  break;
-		}
-	    }
-	}
-      /* Common part.  */
-      (*transfun)(i, &changed, in[i], out[i], gen[i], kill[i], data);
-      RESET_BIT (pending, i);
-      if (changed)
-	{
-	  if (dir == DF_FORWARD)
-	    {
-	      for (e = bb->succ; e != 0; e = e->succ_next)
-		{
-		  if (e->dest == EXIT_BLOCK_PTR || e->dest->index == i)
-		    continue;
-		  SET_BIT (pending, e->dest->index);
-		}
-	    }
-	  else
-	    {
-	      for (e = bb->pred; e != 0; e = e->pred_next)
-		{
-		  if (e->src == ENTRY_BLOCK_PTR || e->dest->index == i)
-		    continue;
-		  SET_BIT (pending, e->src->index);
-		}
-	    }
-	}
-    }
-  if (dir == DF_FORWARD)
-    {
-      for (e = bb->succ; e != 0; e = e->succ_next)
-	{
-	  if (e->dest == EXIT_BLOCK_PTR || e->dest->index == i)
-	    continue;
-	  if (!TEST_BIT (visited, e->dest->index))
-	    hybrid_search_sbitmap (e->dest, in, out, gen, kill, dir,
-				   conf_op, transfun, visited, pending,
-				   data);
-	}
-    }
-  else
-    {
-      for (e = bb->pred; e != 0; e = e->pred_next)
-	{
-	  if (e->src == ENTRY_BLOCK_PTR || e->src->index == i)
-	    continue;
-	  if (!TEST_BIT (visited, e->src->index))
-	    hybrid_search_sbitmap (e->src, in, out, gen, kill, dir,
-				   conf_op, transfun, visited, pending,
-				   data);
+	  SET_BIT (pending, e->src->index);
+	  fibheap_insert (worklist, order[e->src->index],
+			  (void *) (size_t) e->src->index);
 	}
     }
 }
@@ -3574,10 +3396,16 @@ hybrid_search_sbitmap (basic_block block, sbitmap *in, sbitmap *out,
    others.  However, it'll only put what you say to analyze on the
    initial worklist.
 
+   The worklist is a priority queue keyed by ORDER.  A block is put
+   back on it only when the out set of a predecessor (for forward
+   problems) or the in set of a successor (for backward problems)
+   changes, so blocks whose inputs are stable are not evaluated again.
+   Return the number of blocks evaluated.
+
    For forward problems, you probably want to pass in a mapping of
    block number to rc_order (like df->inverse_rc_map).
 */
-void
+int
 iterative_dataflow_sbitmap (sbitmap *in, sbitmap *out, sbitmap *gen,
 			    sbitmap *kill, bitmap blocks,
 			    enum df_flow_dir dir,
@@ -3585,15 +3413,15 @@ iterative_dataflow_sbitmap (sbitmap *in, sbitmap *out, sbitmap *gen,
 			    transfer_function_sbitmap transfun, int *order,
 			    void *data)
 {
-  int i;
+  int i, changed;
+  int visits = 0;
   fibheap_t worklist;
   basic_block bb;
-  sbitmap visited, pending;
+  sbitmap pending;
+  edge e;
 
   pending = sbitmap_alloc (last_basic_block);
-  visited = sbitmap_alloc (last_basic_block);
   sbitmap_zero (pending);
-  sbitmap_zero (visited);
   worklist = fibheap_new ();
 
   EXECUTE_IF_SET_IN_BITMAP (blocks, 0, i,
@@ -3606,55 +3434,82 @@ iterative_dataflow_sbitmap (sbitmap *in, sbitmap *out, sbitmap *gen,
       sbitmap_copy (in[i], gen[i]);
   });
 
-  while (sbitmap_first_set_bit (pending) != -1)
+  while (!fibheap_empty (worklist))
     {
-      while (!fibheap_empty (worklist))
-	{
-	  i = (size_t) fibheap_extract_min (worklist);
-	  bb = BASIC_BLOCK (i);
-	  if (!TEST_BIT (visited, bb->index))
-	    hybrid_search_sbitmap (bb, in, out, gen, kill, dir,
-				   conf_op, transfun, visited, pending, data);
-	}
+      i = (size_t) fibheap_extract_min (worklist);
+      bb = BASIC_BLOCK (i);
+      RESET_BIT (pending, i);
+      visits++;
 
-      if (sbitmap_first_set_bit (pending) != -1)
+      if (dir == DF_FORWARD)
 	{
-	  EXECUTE_IF_SET_IN_BITMAP (blocks, 0, i,
-	  {
-	    fibheap_insert (worklist, order[i], (void *) (size_t) i);
-	  });
-	  sbitmap_zero (visited);
+	  /* Calculate <conf_op> of predecessor_outs.  */
+	  sbitmap_zero (in[i]);
+	  for (e = bb->pred; e != 0; e = e->pred_next)
+	    {
+	      if (e->src == ENTRY_BLOCK_PTR)
+		continue;
+	      switch (conf_op)
+		{
+		case DF_UNION:
+		  sbitmap_a_or_b (in[i], in[i], out[e->src->index]);
+		  break;
+		case DF_INTERSECTION:
+		  sbitmap_a_and_b (in[i], in[i], out[e->src->index]);
+		  break;
+		}
+	    }
 	}
       else
 	{
-	  break;
+	  /* Calculate <conf_op> of successor ins.  */
+	  sbitmap_zero (out[i]);
+	  for (e = bb->succ; e != 0; e = e->succ_next)
+	    {
+	      if (e->dest == EXIT_BLOCK_PTR)
+		continue;
+	      switch (conf_op)
+		{
+		case DF_UNION:
+		  sbitmap_a_or_b (out[i], out[i], in[e->dest->index]);
+		  break;
+		case DF_INTERSECTION:
+		  sbitmap_a_and_b (out[i], out[i], in[e->dest->index]);
+		  break;
+		}
+	    }
 	}
+
+      (*transfun)(i, &changed, in[i], out[i], gen[i], kill[i], data);
+      if (changed)
+	df_worklist_add_deps (bb, dir, order, worklist, pending);
     }
 
   sbitmap_free (pending);
-  sbitmap_free (visited);
   fibheap_delete (worklist);
+
+  return visits;
 }
 
 
 /* Exactly the same as iterative_dataflow_sbitmap, except it works on
    bitmaps instead.  */
-void
+int
 iterative_dataflow_bitmap (bitmap *in, bitmap *out, bitmap *gen, bitmap *kill,
 			   bitmap blocks, enum df_flow_dir dir,
 			   enum df_confluence_op conf_op,
 			   transfer_function_bitmap transfun, int *order,
 			   void *data)
 {
-  int i;
+  int i, changed;
+  int visits = 0;
   fibheap_t worklist;
   basic_block bb;
-  sbitmap visited, pending;
+  sbitmap pending;
+  edge e;
 
   pending = sbitmap_alloc (last_basic_block);
-  visited = sbitmap_alloc (last_basic_block);
   sbitmap_zero (pending);
-  sbitmap_zero (visited);
   worklist = fibheap_new ();
 
   EXECUTE_IF_SET_IN_BITMAP (blocks, 0, i,
@@ -3667,31 +3522,59 @@ iterative_dataflow_bitmap (bitmap *in, bitmap *out, bitmap *gen, bitmap *kill,
       bitmap_copy (in[i], gen[i]);
   });
 
-  while (sbitmap_first_set_bit (pending) != -1)
+  while (!fibheap_empty (worklist))
     {
-      while (!fibheap_empty (worklist))
-	{
-	  i = (size_t) fibheap_extract_min (worklist);
-	  bb = BASIC_BLOCK (i);
-	  if (!TEST_BIT (visited, bb->index))
-	    hybrid_search_bitmap (bb, in, out, gen, kill, dir,
-				  conf_op, transfun, visited, pending, data);
-	}
+      i = (size_t) fibheap_extract_min (worklist);
+      bb = BASIC_BLOCK (i);
+      RESET_BIT (pending, i);
+      visits++;
 
-      if (sbitmap_first_set_bit (pending) != -1)
+      if (dir == DF_FORWARD)
 	{
-	  EXECUTE_IF_SET_IN_BITMAP (blocks, 0, i,
-	  {
-	    fibheap_insert (worklist, order[i], (void *) (size_t) i);
-	  });
-	  sbitmap_zero (visited);
+	  /*  Calculate <conf_op> of predecessor_outs.  */
+	  bitmap_zero (in[i]);
+	  for (e = bb->pred; e != 0; e = e->pred_next)
+	    {
+	      if (e->src == ENTRY_BLOCK_PTR)
+		continue;
+	      switch (conf_op)
+		{
+		case DF_UNION:
+		  bitmap_a_or_b (in[i], in[i], out[e->src->index]);
+		  break;
+		case DF_INTERSECTION:
+		  bitmap_a_and_b (in[i], in[i], out[e->src->index]);
+		  break;
+		}
+	    }
 	}
       else
 	{
-	  break;
+	  /* Calculate <conf_op> of successor ins.  */
+	  bitmap_zero (out[i]);
+	  for (e = bb->succ; e != 0; e = e->succ_next)
+	    {
+	      if (e->dest == EXIT_BLOCK_PTR)
+		continue;
+	      switch (conf_op)
+		{
+		case DF_UNION:
+		  bitmap_a_or_b (out[i], out[i], in[e->dest->index]);
+		  break;
+		case DF_INTERSECTION:
+		  bitmap_a_and_b (out[i], out[i], in[e->dest->index]);
+		  break;
+		}
+	    }
 	}
+
+      (*transfun)(i, &changed, in[i], out[i], gen[i], kill[i], data);
+      if (changed)
+	df_worklist_add_deps (bb, dir, order, worklist, pending);
     }
+
   sbitmap_free (pending);
-  sbitmap_free (visited);
   fibheap_delete (worklist);
+
+  return visits;
 }
@@ -166,6 +166,9 @@ struct df
   int *inverse_rc_map;		/* Block number -> reverse completion order.  */
   int *inverse_dfs_map;		/* Block number -> DFS order.  */
   int *inverse_rts_map;		/* Block number -> reverse top-sort order.  */
+  unsigned int rd_visits;	/* Blocks evaluated to solve RD.  */
+  unsigned int ru_visits;	/* Blocks evaluated to solve RU.  */
+  unsigned int lr_visits;	/* Blocks evaluated to solve LR.  */
 };
 
 
@@ -336,16 +339,16 @@ typedef void (*transfer_function_sbitmap) (int, int *, sbitmap, sbitmap,
 typedef void (*transfer_function_bitmap) (int, int *, bitmap, bitmap,
 					  bitmap, bitmap, void *);
 
-extern void iterative_dataflow_sbitmap (sbitmap *, sbitmap *, sbitmap *,
-					sbitmap *, bitmap, enum df_flow_dir,
-					enum df_confluence_op,
-					transfer_function_sbitmap,
-					int *, void *);
-
-extern void iterative_dataflow_bitmap (bitmap *, bitmap *, bitmap *,
-				       bitmap *, bitmap,
-				       enum df_flow_dir,
+extern int iterative_dataflow_sbitmap (sbitmap *, sbitmap *, sbitmap *,
+				       sbitmap *, bitmap, enum df_flow_dir,
 				       enum df_confluence_op,
-				       transfer_function_bitmap,
+				       transfer_function_sbitmap,
 				       int *, void *);
+
+extern int iterative_dataflow_bitmap (bitmap *, bitmap *, bitmap *,
+				      bitmap *, bitmap,
+				      enum df_flow_dir,
+				      enum df_confluence_op,
+				      transfer_function_bitmap,
+				      int *, void *);
 extern bool read_modify_subreg_p (rtx);
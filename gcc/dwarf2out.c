@@ -3568,6 +3568,12 @@ static GTY(()) unsigned abbrev_die_table_in_use;
    abbrev_die_table.  */
 #define ABBREV_DIE_TABLE_INCREMENT 256
 
+/* A hash table of the DIEs in abbrev_die_table, keyed by the
+   abbreviation they need, so that build_abbrev_table does not have to
+   compare each DIE with every abbreviation seen so far.  The DIEs are
+   kept alive by abbrev_die_table.  */
+static htab_t abbrev_die_hash;
+
 /* A pointer to the base of a table that contains line information
    for each source code line in .text in the compilation unit.  */
 static GTY((length ("line_info_table_allocated")))
@@ -3744,6 +3750,7 @@ static int same_die_p_wrap (dw_die_ref, dw_die_ref);
 static void compute_section_prefix (dw_die_ref);
 static int is_type_die (dw_die_ref);
 static int is_comdat_die (dw_die_ref);
+static int is_type_unit_die (dw_die_ref);
 static int is_symbol_die (dw_die_ref);
 static void assign_symbol_names (dw_die_ref);
 static void break_out_includes (dw_die_ref);
@@ -3753,6 +3760,9 @@ static void htab_cu_del (void *);
 static int check_duplicate_cu (dw_die_ref, htab_t, unsigned *);
 static void record_comdat_symbol_number (dw_die_ref, htab_t, unsigned);
 static void add_sibling_attributes (dw_die_ref);
+static hashval_t abbrev_hash (dw_die_ref);
+static hashval_t htab_abbrev_hash (const void *);
+static int htab_abbrev_eq (const void *, const void *);
 static void build_abbrev_table (dw_die_ref);
 static void output_location_lists (dw_die_ref);
 static int constant_size (long unsigned);
@@ -5910,12 +5920,29 @@ compute_section_prefix (dw_die_ref unit_die)
 {
   const char *die_name = get_AT_string (unit_die, DW_AT_name);
   const char *base = die_name ? lbasename (die_name) : "anonymous";
-  char *name = alloca (strlen (base) + 64);
+  char *name;
   char *p;
   int i, mark;
   unsigned char checksum[16];
   struct md5_ctx ctx;
 
+  /* The units that break_out_includes makes for single types have no
+     name of their own; use that of the type, so that two types from
+     the same header are told apart by more than the checksum.  Keep
+     the long names of template instances within bounds.  */
+  if (die_name == NULL && unit_die->die_child != NULL
+      && (die_name = get_AT_string (unit_die->die_child, DW_AT_name)))
+    {
+      size_t len = MIN (strlen (die_name), 64);
+      char *type_name = alloca (len + 1);
+
+      memcpy (type_name, die_name, len);
+      type_name[len] = '\0';
+      base = type_name;
+    }
+
+  name = alloca (strlen (base) + 64);
+
   /* Compute the checksum of the DIE, then append part of it as hex digits to
      the name filename of the unit.  */
 
@@ -5999,6 +6026,28 @@ is_comdat_die (dw_die_ref c)
   return is_type_die (c);
 }
 
+/* Returns 1 iff C is a named class, structure, union or enumeration that
+   should go into a COMDAT CU of its own.  The C++ front end does not emit
+   the DIEs for classes until the end of the translation unit, long after
+   the BINCL/EINCL pairs of their headers, so without this they would all
+   stay in the main CU.  */
+
+static int
+is_type_unit_die (dw_die_ref c)
+{
+  switch (c->die_tag)
+    {
+    case DW_TAG_class_type:
+    case DW_TAG_structure_type:
+    case DW_TAG_union_type:
+    case DW_TAG_enumeration_type:
+      return (get_AT_string (c, DW_AT_name) != NULL
+	      && ! get_AT_flag (c, DW_AT_declaration));
+    default:
+      return 0;
+    }
+}
+
 /* Returns 1 iff C is the sort of DIE that might be referred to from another
    compilation unit.  */
 
@@ -6134,7 +6183,8 @@ record_comdat_symbol_number (dw_die_ref cu, htab_t htable, unsigned int sym_num)
 
 /* Traverse the DIE (which is always comp_unit_die), and set up
    additional compilation units for each of the include files we see
-   bracketed by BINCL/EINCL.  */
+   bracketed by BINCL/EINCL.  For C++, also set up one for each class
+   left outside them.  */
 
 static void
 break_out_includes (dw_die_ref die)
@@ -6167,6 +6217,12 @@ break_out_includes (dw_die_ref die)
 	  else
 	    add_child_die (unit, c);
 	}
+      else if (unit == NULL && is_cxx () && is_type_unit_die (c))
+	{
+	  /* Give this class a CU of its own.  */
+	  *ptr = c->die_sib;
+	  add_child_die (gen_compile_unit_die (NULL), c);
+	}
       else
 	{
 	  /* Leave this DIE in the main CU.  */
@@ -6241,6 +6297,50 @@ output_location_lists (dw_die_ref die)
 
 }
 
+/* Compute a hash of the abbreviation DIE needs: its tag, whether it
+   has children, and the form of each of its attributes.  */
+
+static hashval_t
+abbrev_hash (dw_die_ref die)
+{
+  hashval_t hash = die->die_tag * 2 + (die->die_child != NULL);
+  dw_attr_ref a;
+
+  for (a = die->die_attr; a; a = a->dw_attr_next)
+    hash = (hash * 67 + a->dw_attr) * 67 + value_format (a);
+
+  return hash;
+}
+
+/* Routines to manipulate the hash table of abbreviations.  */
+
+static hashval_t
+htab_abbrev_hash (const void *of)
+{
+  return abbrev_hash ((dw_die_ref) of);
+}
+
+static int
+htab_abbrev_eq (const void *of1, const void *of2)
+{
+  dw_die_ref abbrev = (dw_die_ref) of1;
+  dw_die_ref die = (dw_die_ref) of2;
+  dw_attr_ref a_attr, d_attr;
+
+  if (abbrev->die_tag != die->die_tag
+      || (abbrev->die_child != NULL) != (die->die_child != NULL))
+    return 0;
+
+  for (a_attr = abbrev->die_attr, d_attr = die->die_attr;
+       a_attr != NULL && d_attr != NULL;
+       a_attr = a_attr->dw_attr_next, d_attr = d_attr->dw_attr_next)
+    if ((a_attr->dw_attr != d_attr->dw_attr)
+	|| (value_format (a_attr) != value_format (d_attr)))
+      return 0;
+
+  return a_attr == NULL && d_attr == NULL;
+}
+
 /* The format of each DIE (and its attribute value pairs) is encoded in an
    abbreviation table.  This routine builds the abbreviation table and assigns
    a unique abbreviation id for each abbreviation entry.  The children of each
@@ -6252,7 +6352,8 @@ build_abbrev_table (dw_die_ref die)
   unsigned long abbrev_id;
   unsigned int n_alloc;
   dw_die_ref c;
-  dw_attr_ref d_attr, a_attr;
+  dw_attr_ref d_attr;
+  void **slot;
 
   /* Scan the DIE references, and mark as external any that refer to
      DIEs from other CUs (i.e. those which are not marked).  */
@@ -6266,34 +6367,15 @@ build_abbrev_table (dw_die_ref die)
 	set_AT_ref_external (d_attr, 1);
       }
 
-  for (abbrev_id = 1; abbrev_id < abbrev_die_table_in_use; ++abbrev_id)
-    {
-      dw_die_ref abbrev = abbrev_die_table[abbrev_id];
-
-      if (abbrev->die_tag == die->die_tag)
-	{
-	  if ((abbrev->die_child != NULL) == (die->die_child != NULL))
-	    {
-	      a_attr = abbrev->die_attr;
-	      d_attr = die->die_attr;
-
-	      while (a_attr != NULL && d_attr != NULL)
-		{
-		  if ((a_attr->dw_attr != d_attr->dw_attr)
-		      || (value_format (a_attr) != value_format (d_attr)))
-		    break;
+  if (abbrev_die_hash == NULL)
+    abbrev_die_hash = htab_create (ABBREV_DIE_TABLE_INCREMENT,
+				   htab_abbrev_hash, htab_abbrev_eq, NULL);
 
-		  a_attr = a_attr->dw_attr_next;
-		  d_attr = d_attr->dw_attr_next;
-		}
-
-	      if (a_attr == NULL && d_attr == NULL)
-		break;
-	    }
-	}
-    }
-
-  if (abbrev_id >= abbrev_die_table_in_use)
+  slot = htab_find_slot_with_hash (abbrev_die_hash, die, abbrev_hash (die),
+				   INSERT);
+  if (*slot != NULL)
+    abbrev_id = ((dw_die_ref) *slot)->die_abbrev;
+  else
     {
       if (abbrev_die_table_in_use >= abbrev_die_table_allocated)
 	{
@@ -6306,8 +6388,9 @@ build_abbrev_table (dw_die_ref die)
 	  abbrev_die_table_allocated = n_alloc;
 	}
 
-      ++abbrev_die_table_in_use;
+      abbrev_id = abbrev_die_table_in_use++;
       abbrev_die_table[abbrev_id] = die;
+      *slot = die;
     }
 
   die->die_abbrev = abbrev_id;
@@ -3047,8 +3047,7 @@ output_asm_insn (const char *template, rtx *operands)
 	    else if (letter == 'n')
 	      {
 		if (GET_CODE (operands[c]) == CONST_INT)
-		  fprintf (asm_out_file, HOST_WIDE_INT_PRINT_DEC,
-			   - INTVAL (operands[c]));
+		  fprint_w (asm_out_file, - INTVAL (operands[c]));
 		else
 		  {
 		    putc ('-', asm_out_file);
@@ -3161,6 +3160,36 @@ output_address (rtx x)
   PRINT_OPERAND_ADDRESS (asm_out_file, x);
 }
 
+/* Print VALUE to FILE in decimal.  This is what fprintf would print
+   for HOST_WIDE_INT_PRINT_DEC; the integers in large initializers and
+   in instruction operands are frequent enough for the format parsing
+   to show up in profiles.  */
+
+void
+fprint_w (FILE *file, HOST_WIDE_INT value)
+{
+  /* Room for the digits, a sign and the terminating NUL.  */
+  char buf[3 * sizeof (HOST_WIDE_INT) + 2];
+  char *p = buf + sizeof (buf);
+  unsigned HOST_WIDE_INT v = value;
+
+  if (value < 0)
+    v = -v;
+
+  *--p = '\0';
+  do
+    {
+      *--p = '0' + v % 10;
+      v /= 10;
+    }
+  while (v != 0);
+
+  if (value < 0)
+    *--p = '-';
+
+  fputs (p, file);
+}
+
 /* Print an integer constant expression in assembler syntax.
    Addition and subtraction are the only arithmetic
    that may appear in these expressions.  */
@@ -3198,7 +3227,7 @@ output_addr_const (FILE *file, rtx x)
       break;
 
     case CONST_INT:
-      fprintf (file, HOST_WIDE_INT_PRINT_DEC, INTVAL (x));
+      fprint_w (file, INTVAL (x));
       break;
 
     case CONST:
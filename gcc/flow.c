@@ -599,7 +599,7 @@ update_life_info (sbitmap blocks, enum update_life_extent extent, int prop_flags
   regset tmp;
   regset_head tmp_head;
   int i;
-  int stabilized_prop_flags = prop_flags;
+  int stabilized_prop_flags = prop_flags & ~PROP_SKIP_CLEAN_BLOCKS;
   basic_block bb;
 
   tmp = INITIALIZE_REG_SET (tmp_head);
@@ -624,7 +624,8 @@ update_life_info (sbitmap blocks, enum update_life_extent extent, int prop_flags
 	  calculate_global_regs_live (blocks, blocks,
 				prop_flags & (PROP_SCAN_DEAD_CODE
 					      | PROP_SCAN_DEAD_STORES
-					      | PROP_ALLOW_CFG_CHANGES));
+					      | PROP_ALLOW_CFG_CHANGES
+					      | PROP_SKIP_CLEAN_BLOCKS));
 
 	  if ((prop_flags & (PROP_KILL_DEAD_CODE | PROP_ALLOW_CFG_CHANGES))
 	      != (PROP_KILL_DEAD_CODE | PROP_ALLOW_CFG_CHANGES))
@@ -772,6 +773,13 @@ update_life_info_in_dirty_blocks (enum update_life_extent extent, int prop_flags
 	}
     }
 
+  /* All blocks are queued for a global update, but only the dirty ones
+     and those whose live_at_end changes need to be scanned again.
+     Register info is accumulated over the blocks scanned, so it must
+     see all of them.  */
+  if (extent != UPDATE_LIFE_LOCAL && ! (prop_flags & PROP_REG_INFO))
+    prop_flags |= PROP_SKIP_CLEAN_BLOCKS;
+
   if (n)
     retval = update_life_info (update_life_blocks, extent, prop_flags);
 
@@ -1200,6 +1208,15 @@ calculate_global_regs_live (sbitmap blocks_in, sbitmap blocks_out, int flags)
 
       if (bb->local_set == NULL)
 	{
+	  /* The insns of a clean block have not changed since its life
+	     info was last computed, so unless live_at_end changes, neither
+	     does live_at_start.  Leave it alone for now; should it be
+	     queued again, it will be scanned then.  */
+	  if ((flags & PROP_SKIP_CLEAN_BLOCKS)
+	      && ! (bb->flags & BB_DIRTY)
+	      && REG_SET_EQUAL_P (bb->global_live_at_end, new_live_at_end))
+	    continue;
+
 	  bb->local_set = OBSTACK_ALLOC_REG_SET (&flow_obstack);
 	  bb->cond_local_set = OBSTACK_ALLOC_REG_SET (&flow_obstack);
 	  rescan = 1;
@@ -346,6 +346,13 @@ static struct globals
   /* Bytes currently allocated at the end of the last collection.  */
   size_t allocated_last_gc;
 
+  /* Bytes allocated before the last collection, including those it
+     reclaimed.  */
+  unsigned HOST_WIDE_INT total_allocated_last_gc;
+
+  /* The largest value ALLOCATED reached before a collection.  */
+  size_t peak_allocated;
+
   /* Total amount of memory mapped.  */
   size_t bytes_mapped;
 
@@ -366,6 +373,12 @@ static struct globals
   /* A cache of free system pages.  */
   page_entry *free_pages;
 
+  /* A cache of free entries spanning more than one system page, as
+     used for objects larger than a page.  These are kept apart from
+     FREE_PAGES so that finding a single page never has to skip over
+     them, nor finding a large entry over thousands of single pages.  */
+  page_entry *free_large_pages;
+
 #ifdef USING_MALLOC_PAGE_GROUPS
   page_group *page_groups;
 #endif
@@ -716,7 +729,8 @@ alloc_page (unsigned order)
   page = NULL;
 
   /* Check the list of free pages for one we can use.  */
-  for (pp = &G.free_pages, p = *pp; p; pp = &p->next, p = *pp)
+  pp = entry_size == G.pagesize ? &G.free_pages : &G.free_large_pages;
+  for (p = *pp; p; pp = &p->next, p = *pp)
     if (p->bytes == entry_size)
       break;
 
@@ -936,23 +950,29 @@ free_page (page_entry *entry)
 
   adjust_depth ();
 
-  entry->next = G.free_pages;
-  G.free_pages = entry;
+  if (entry->bytes == G.pagesize)
+    {
+      entry->next = G.free_pages;
+      G.free_pages = entry;
+    }
+  else
+    {
+      entry->next = G.free_large_pages;
+      G.free_large_pages = entry;
+    }
 }
 
-/* Release the free page cache to the system.  */
+#ifdef USING_MMAP
+/* Unmap the pages on the free list starting at P.  */
 
 static void
-release_pages (void)
+release_page_list (page_entry *p)
 {
-#ifdef USING_MMAP
-  page_entry *p, *next;
+  page_entry *next;
   char *start;
   size_t len;
 
   /* Gather up adjacent pages so they are unmapped together.  */
-  p = G.free_pages;
-
   while (p)
     {
       start = p->page;
@@ -972,15 +992,18 @@ release_pages (void)
       munmap (start, len);
       G.bytes_mapped -= len;
     }
-
-  G.free_pages = NULL;
+}
 #endif
+
 #ifdef USING_MALLOC_PAGE_GROUPS
-  page_entry **pp, *p;
-  page_group **gp, *g;
+/* Remove the pages belonging to free page groups from the free list
+   pointed to by PP.  */
+
+static void
+release_page_list (page_entry **pp)
+{
+  page_entry *p;
 
-  /* Remove all pages from free page groups from the list.  */
-  pp = &G.free_pages;
   while ((p = *pp) != NULL)
     if (p->group->in_use == 0)
       {
@@ -989,6 +1012,26 @@ release_pages (void)
       }
     else
       pp = &p->next;
+}
+#endif
+
+/* Release the free page cache to the system.  */
+
+static void
+release_pages (void)
+{
+#ifdef USING_MMAP
+  release_page_list (G.free_pages);
+  release_page_list (G.free_large_pages);
+  G.free_pages = NULL;
+  G.free_large_pages = NULL;
+#endif
+#ifdef USING_MALLOC_PAGE_GROUPS
+  page_group **gp, *g;
+
+  /* Remove all pages from free page groups from the lists.  */
+  release_page_list (&G.free_pages);
+  release_page_list (&G.free_large_pages);
 
   /* Remove all free page groups, and release the storage.  */
   gp = &G.page_groups;
@@ -1476,6 +1519,7 @@ ggc_pop_context (void)
 {
   unsigned long omask;
   unsigned int depth, i, e;
+  bool collected;
 #ifdef ENABLE_CHECKING
   unsigned int order;
 #endif
@@ -1486,6 +1530,10 @@ ggc_pop_context (void)
   if (!((G.context_depth_allocations | G.context_depth_collections) & omask))
     return;
 
+  /* Only a collection in the popped context saves in-use bitmaps of the
+     pages in the outer one.  */
+  collected = (G.context_depth_collections & omask) != 0;
+
   G.context_depth_allocations |= (G.context_depth_allocations & omask) >> 1;
   G.context_depth_allocations &= omask - 1;
   G.context_depth_collections &= omask - 1;
@@ -1497,8 +1545,11 @@ ggc_pop_context (void)
   else
     e = G.by_depth_in_use;
 
-  /* We might not have any PTEs of depth depth.  */
-  if (depth < G.depth_in_use)
+  /* We might not have any PTEs of depth depth.  If nothing was
+     collected, there are no in use bits to merge either; skip the walk,
+     which would otherwise visit every page of the outer context each
+     time a pass such as CSE pops its context.  */
+  if (collected && depth < G.depth_in_use)
     {
 
       /* First we go through all the pages at depth depth to
@@ -1789,6 +1840,12 @@ ggc_collect (void)
   if (!quiet_flag)
     fprintf (stderr, " {GC %luk -> ", (unsigned long) G.allocated / 1024);
 
+  /* ALLOCATED only grows between collections, so this is where it
+     peaks.  */
+  G.total_allocated_last_gc += G.allocated - G.allocated_last_gc;
+  if (G.allocated > G.peak_allocated)
+    G.peak_allocated = G.allocated;
+
   /* Zero the total allocated bytes.  This will be recalculated in the
      sweep phase.  */
   G.allocated = 0;
@@ -1817,6 +1874,25 @@ ggc_collect (void)
     fprintf (stderr, "%luk}", (unsigned long) G.allocated / 1024);
 }
 
+/* Return the number of bytes allocated since the start of the
+   compilation.  No allocation is ever freed outside ggc_collect, so
+   this is what the collections have seen plus what has been
+   allocated since the last one.  */
+
+unsigned HOST_WIDE_INT
+ggc_total_allocated (void)
+{
+  return G.total_allocated_last_gc + (G.allocated - G.allocated_last_gc);
+}
+
+/* Return the largest number of bytes that were allocated at once.  */
+
+size_t
+ggc_peak_allocated (void)
+{
+  return MAX (G.peak_allocated, G.allocated);
+}
+
 /* Print allocation statistics.  */
 #define SCALE(x) ((unsigned long) ((x) < 1024*10 \
 		  ? (x) \
@@ -2212,5 +2288,6 @@ ggc_pch_read (FILE *f, void *addr)
   move_ptes_to_front (count_old_page_tables, count_new_page_tables);
 
   /* Update the statistics.  */
+  G.total_allocated_last_gc += G.allocated - G.allocated_last_gc;
   G.allocated = G.allocated_last_gc = offs - (char *)addr;
 }
@@ -104,6 +104,13 @@ static struct globals
   /* Data bytes allocated at time of last GC.  */
   size_t allocated_last_gc;
 
+  /* Data bytes allocated since the start of the compilation, including
+     those since reclaimed.  */
+  unsigned HOST_WIDE_INT total_allocated;
+
+  /* The largest value ALLOCATED reached before a collection.  */
+  size_t peak_allocated;
+
   /* Current context level.  */
   int context;
 } G;
@@ -199,6 +206,7 @@ ggc_alloc (size_t size)
 
   tree_insert (x);
   G.allocated += size;
+  G.total_allocated += size;
   G.objects += 1;
 
   return &x->u;
@@ -338,6 +346,11 @@ ggc_collect (void)
   if (!quiet_flag)
     fprintf (stderr, " {GC %luk -> ", (unsigned long)G.allocated / 1024);
 
+  /* ALLOCATED only grows between collections, so this is where it
+     peaks.  */
+  if (G.allocated > G.peak_allocated)
+    G.peak_allocated = G.allocated;
+
   G.allocated = 0;
   G.objects = 0;
 
@@ -357,6 +370,23 @@ ggc_collect (void)
 #endif
 }
 
+/* Return the number of bytes allocated since the start of the
+   compilation.  */
+
+unsigned HOST_WIDE_INT
+ggc_total_allocated (void)
+{
+  return G.total_allocated;
+}
+
+/* Return the largest number of bytes that were allocated at once.  */
+
+size_t
+ggc_peak_allocated (void)
+{
+  return MAX (G.peak_allocated, G.allocated);
+}
+
 /* Called once to initialize the garbage collector.  */
 
 void
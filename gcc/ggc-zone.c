@@ -260,6 +260,14 @@ static struct globals
 
   /* The file descriptor for debugging output.  */
   FILE *debug_file;
+
+  /* Bytes allocated in all zones before their last collections,
+     including those the collections reclaimed.  */
+  unsigned HOST_WIDE_INT total_allocated_last_gc;
+
+  /* The largest number of bytes allocated in all zones together
+     before a collection.  */
+  size_t peak_allocated;
 } G;
 
 /*  The zone allocation structure.  */
@@ -916,10 +924,13 @@ ggc_pop_context_1 (struct alloc_zone *zone)
 
   /* Any remaining pages in the popped context are lowered to the new
      current context; i.e. objects allocated in the popped context and
-     left over are imported into the previous context.  */
-  for (p = zone->pages; p != NULL; p = p->next)
-    if (p->context_depth > depth)
-      p->context_depth = depth;
+     left over are imported into the previous context.  New pages are
+     pushed on the front of the list with the current depth, so the
+     pages of the popped context form a prefix of ZONE->PAGES and we
+     can stop at the first page of an outer context instead of walking
+     the whole zone.  */
+  for (p = zone->pages; p != NULL && p->context_depth > depth; p = p->next)
+    p->context_depth = depth;
 }
 
 /* Pop all the zone contexts.  */
@@ -1079,6 +1090,8 @@ ggc_collect_1 (struct alloc_zone *zone, bool need_marking)
     fprintf (stderr, " {%s GC %luk -> ",
 	     zone->name, (unsigned long) zone->allocated / 1024);
 
+  G.total_allocated_last_gc += zone->allocated - zone->allocated_last_gc;
+
   /* Zero the total allocated bytes.  This will be recalculated in the
      sweep phase.  */
   zone->allocated = 0;
@@ -1160,6 +1173,11 @@ ggc_collect (void)
 
   timevar_push (TV_GC);
   check_cookies ();
+
+  /* Allocations only grow between collections, so this is where the
+     heap peaks.  */
+  G.peak_allocated = ggc_peak_allocated ();
+
   /* Start by possibly collecting the main zone.  */
   main_zone.was_collected = false;
   marked |= ggc_collect_1 (&main_zone, true);
@@ -1264,6 +1282,33 @@ ggc_print_statistics (void)
 {
 }
 
+/* Return the number of bytes allocated since the start of the
+   compilation, in all zones.  */
+
+unsigned HOST_WIDE_INT
+ggc_total_allocated (void)
+{
+  unsigned HOST_WIDE_INT total = G.total_allocated_last_gc;
+  struct alloc_zone *zone;
+
+  for (zone = G.zones; zone; zone = zone->next_zone)
+    total += zone->allocated - zone->allocated_last_gc;
+  return total;
+}
+
+/* Return the largest number of bytes that were allocated at once.  */
+
+size_t
+ggc_peak_allocated (void)
+{
+  size_t allocated = 0;
+  struct alloc_zone *zone;
+
+  for (zone = G.zones; zone; zone = zone->next_zone)
+    allocated += zone->allocated;
+  return MAX (G.peak_allocated, allocated);
+}
+
 struct ggc_pch_data
 {
   struct ggc_pch_ondisk
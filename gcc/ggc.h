@@ -280,6 +280,13 @@ extern void ggc_print_common_statistics (FILE *, ggc_statistics *);
 
 /* Print allocation statistics.  */
 extern void ggc_print_statistics (void);
+
+/* Return the number of bytes allocated since the start of the
+   compilation, including those since reclaimed by collections.  */
+extern unsigned HOST_WIDE_INT ggc_total_allocated (void);
+
+/* Return the largest number of bytes that were allocated at once.  */
+extern size_t ggc_peak_allocated (void);
 extern void stringpool_statistics (void);
 
 /* Heuristics.  */
@@ -68,6 +68,16 @@ extern void ht_destroy (hash_table *);
 
 extern hashnode ht_lookup (hash_table *, const unsigned char *,
 			   size_t, enum ht_lookup_option);
+extern hashnode ht_lookup_with_hash (hash_table *, const unsigned char *,
+				     size_t, unsigned int,
+				     enum ht_lookup_option);
+
+/* The hash of a string is computed by starting with zero, applying
+   HT_HASHSTEP to each of its characters in turn, and finishing with
+   HT_HASHFINISH.  This lets a caller that is scanning the string anyway
+   compute its hash on the fly for ht_lookup_with_hash.  */
+#define HT_HASHSTEP(r, c) ((r) * 67 + ((c) - 113))
+#define HT_HASHFINISH(r, len) ((r) + (len))
 
 /* For all nodes in TABLE, make a callback.  The callback takes
    TABLE->PFILE, the node, and a PTR, and the callback sequence stops
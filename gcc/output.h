@@ -106,6 +106,9 @@ extern void output_address (rtx);
    that may appear in these expressions.  */
 extern void output_addr_const (FILE *, rtx);
 
+/* Print a HOST_WIDE_INT in decimal.  */
+extern void fprint_w (FILE *, HOST_WIDE_INT);
+
 /* Output a string of assembler code, substituting numbers, strings
    and fixed syntactic prefixes.  */
 #if GCC_VERSION >= 3004
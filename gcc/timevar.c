@@ -32,6 +32,7 @@ Software Foundation, 59 Temple Place - Suite 330, Boston, MA
 #include "intl.h"
 #include "rtl.h"
 #include "toplev.h"
+#include "ggc.h"
 
 #ifndef HAVE_CLOCK_T
 typedef int clock_t;
@@ -183,10 +184,13 @@ get_time (struct timevar_time_def *now)
   now->user = 0;
   now->sys  = 0;
   now->wall = 0;
+  now->ggc_mem = 0;
 
   if (!timevar_enable)
     return;
 
+  now->ggc_mem = ggc_total_allocated ();
+
   {
 #ifdef USE_TIMES
     struct tms tms;
@@ -216,6 +220,7 @@ timevar_accumulate (struct timevar_time_def *timer,
   timer->user += stop_time->user - start_time->user;
   timer->sys += stop_time->sys - start_time->sys;
   timer->wall += stop_time->wall - start_time->wall;
+  timer->ggc_mem += stop_time->ggc_mem - start_time->ggc_mem;
 }
 
 /* Initialize timing variables.  */
@@ -442,6 +447,7 @@ timevar_print (FILE *fp)
     {
       struct timevar_def *tv = &timevars[(timevar_id_t) id];
       const double tiny = 5e-3;
+      const unsigned HOST_WIDE_INT tiny_mem = 1024;
 
       /* Don't print the total execution time here; that goes at the
 	 end.  */
@@ -456,7 +462,8 @@ timevar_print (FILE *fp)
          zeroes.  */
       if (tv->elapsed.user < tiny
 	  && tv->elapsed.sys < tiny
-	  && tv->elapsed.wall < tiny)
+	  && tv->elapsed.wall < tiny
+	  && tv->elapsed.ggc_mem < tiny_mem)
 	continue;
 
       /* The timing variable name.  */
@@ -483,6 +490,12 @@ timevar_print (FILE *fp)
 	       (total->wall == 0 ? 0 : tv->elapsed.wall / total->wall) * 100);
 #endif /* HAVE_WALL_TIME */
 
+      /* Print the amount of GC memory allocated.  */
+      fprintf (fp, "%8lu kB (%2.0f%%) ggc",
+	       (unsigned long) (tv->elapsed.ggc_mem >> 10),
+	       (total->ggc_mem == 0
+		? 0 : (double) tv->elapsed.ggc_mem / total->ggc_mem) * 100);
+
       putc ('\n', fp);
     }
 
@@ -495,8 +508,13 @@ timevar_print (FILE *fp)
   fprintf (fp, "%7.2f          ", total->sys);
 #endif
 #ifdef HAVE_WALL_TIME
-  fprintf (fp, "%7.2f\n", total->wall);
+  fprintf (fp, "%7.2f           ", total->wall);
 #endif
+  fprintf (fp, "%8lu kB\n", (unsigned long) (total->ggc_mem >> 10));
+
+  /* Print the high-water mark of the GC heap.  */
+  fprintf (fp, _(" GC memory peak        :%8lu kB\n"),
+	   (unsigned long) (ggc_peak_allocated () >> 10));
 
 #endif /* defined (HAVE_USER_TIME) || defined (HAVE_SYS_TIME)
 	  || defined (HAVE_WALL_TIME) */
@@ -48,7 +48,8 @@
    measured.  Times are stored in seconds.  The time may be an
    absolute time or a time difference; in the former case, the time
    base is undefined, except that the difference between two times
-   produces a valid time difference.  */
+   produces a valid time difference.  The amount of garbage collected
+   memory allocated is kept alongside, in the same manner.  */
 
 struct timevar_time_def
 {
@@ -61,6 +62,9 @@ struct timevar_time_def
 
   /* Wall clock time.  */
   double wall;
+
+  /* Bytes of garbage collected memory allocated.  */
+  unsigned HOST_WIDE_INT ggc_mem;
 };
 
 /* An enumeration of timing variable identifiers.  Constructed from
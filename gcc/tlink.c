@@ -38,6 +38,10 @@ Software Foundation, 59 Temple Place - Suite 330, Boston, MA
 extern int prepends_underscore;
 
 static int tlink_verbose;
+
+/* The number of recompilations that may be run at once.  */
+
+static int tlink_jobs;
 
 /* Hash table boilerplate for working with htab_t.  We have hash tables
    for symbol names, file names, and demangled symbols.  */
@@ -261,6 +265,11 @@ tlink_init (void)
   obstack_begin (&symbol_stack_obstack, 0);
   obstack_begin (&file_stack_obstack, 0);
 
+  p = getenv ("TLINK_JOBS");
+  tlink_jobs = p ? atoi (p) : 1;
+  if (tlink_jobs < 1)
+    tlink_jobs = 1;
+
   p = getenv ("TLINK_VERBOSE");
   if (p)
     tlink_verbose = atoi (p);
@@ -432,61 +441,99 @@ maybe_tweak (char *line, file *f)
 }
 
 /* Update the repo files for each of the object files we have adjusted and
-   recompile.
-
-   XXX Should this use collect_execute instead of system?  */
+   recompile.  Up to TLINK_JOBS files are recompiled at once; the repo
+   files of each batch are rewritten before any of them is recompiled,
+   and read back in once they all have been.  */
 
 static int
 recompile_files (void)
 {
   file *f;
+  file **batch = xmalloc (tlink_jobs * sizeof (file *));
+  int *pids = xmalloc (tlink_jobs * sizeof (int));
+  int ok = 1;
 
   putenv (xstrdup ("COMPILER_PATH="));
   putenv (xstrdup ("LIBRARY_PATH="));
 
-  while ((f = file_pop ()) != NULL)
+  while (ok && file_stack != NULL)
     {
-      char *line, *command;
-      FILE *stream = fopen (f->key, "r");
-      const char *const outname = frob_extension (f->key, ".rnw");
-      FILE *output = fopen (outname, "w");
+      int n, i;
 
-      while ((line = tfgets (stream)) != NULL)
+      for (n = 0; n < tlink_jobs && (f = file_pop ()) != NULL; n++)
 	{
-	  switch (line[0])
+	  char *line, *command;
+	  char *argv[4];
+	  char *errmsg_fmt, *errmsg_arg;
+	  FILE *stream = fopen (f->key, "r");
+	  const char *const outname = frob_extension (f->key, ".rnw");
+	  FILE *output = fopen (outname, "w");
+
+	  while ((line = tfgets (stream)) != NULL)
 	    {
-	    case 'C':
-	    case 'O':
-	      maybe_tweak (line, f);
+	      switch (line[0])
+		{
+		case 'C':
+		case 'O':
+		  maybe_tweak (line, f);
+		}
+	      fprintf (output, "%s\n", line);
 	    }
-	  fprintf (output, "%s\n", line);
+	  fclose (stream);
+	  fclose (output);
+	  rename (outname, f->key);
+
+	  obstack_grow (&temporary_obstack, "cd ", 3);
+	  obstack_grow (&temporary_obstack, f->dir, strlen (f->dir));
+	  obstack_grow (&temporary_obstack, "; ", 2);
+	  obstack_grow (&temporary_obstack, c_file_name, strlen (c_file_name));
+	  obstack_1grow (&temporary_obstack, ' ');
+	  obstack_grow (&temporary_obstack, f->args, strlen (f->args));
+	  obstack_1grow (&temporary_obstack, ' ');
+	  command = obstack_copy0 (&temporary_obstack, f->main,
+				   strlen (f->main));
+
+	  if (tlink_verbose)
+	    fprintf (stderr, _("collect: recompiling %s\n"), f->main);
+	  if (tlink_verbose >= 3)
+	    fprintf (stderr, "%s\n", command);
+
+	  fflush (stdout);
+	  fflush (stderr);
+
+	  argv[0] = (char *) "sh";
+	  argv[1] = (char *) "-c";
+	  argv[2] = command;
+	  argv[3] = NULL;
+	  pids[n] = pexecute (argv[0], argv, argv[0], NULL,
+			      &errmsg_fmt, &errmsg_arg,
+			      (PEXECUTE_FIRST | PEXECUTE_LAST
+			       | PEXECUTE_SEARCH));
+	  if (pids[n] == -1)
+	    fatal_perror (errmsg_fmt, errmsg_arg);
+	  batch[n] = f;
 	}
-      fclose (stream);
-      fclose (output);
-      rename (outname, f->key);
-
-      obstack_grow (&temporary_obstack, "cd ", 3);
-      obstack_grow (&temporary_obstack, f->dir, strlen (f->dir));
-      obstack_grow (&temporary_obstack, "; ", 2);
-      obstack_grow (&temporary_obstack, c_file_name, strlen (c_file_name));
-      obstack_1grow (&temporary_obstack, ' ');
-      obstack_grow (&temporary_obstack, f->args, strlen (f->args));
-      obstack_1grow (&temporary_obstack, ' ');
-      command = obstack_copy0 (&temporary_obstack, f->main, strlen (f->main));
-
-      if (tlink_verbose)
-	fprintf (stderr, _("collect: recompiling %s\n"), f->main);
-      if (tlink_verbose >= 3)
-	fprintf (stderr, "%s\n", command);
-
-      if (system (command) != 0)
-	return 0;
 
-      read_repo_file (f);
+      /* Wait for the whole batch, even if one of them fails.  */
+      for (i = 0; i < n; i++)
+	{
+	  int status;
+
+	  pwait (pids[i], &status, 0);
+	  if (status != 0)
+	    ok = 0;
+	}
+
+      if (ok)
+	for (i = 0; i < n; i++)
+	  read_repo_file (batch[i]);
 
       obstack_free (&temporary_obstack, temporary_firstobj);
     }
-  return 1;
+
+  free (batch);
+  free (pids);
+  return ok;
 }
 
 /* The first phase of processing: determine which object files have
@@ -317,6 +317,8 @@ htab_empty (htab)
 	(*htab->del_f) (htab->entries[i]);
 
   memset (htab->entries, 0, htab->size * sizeof (PTR));
+  htab->n_deleted = 0;
+  htab->n_elements = 0;
 }
 
 /* Similar to htab_find_slot, but without several unwanted side effects: